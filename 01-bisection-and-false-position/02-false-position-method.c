@@ -1,9 +1,19 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/expression.h"
+#include "../common/trace.h"
 #define TOLERANCE 0.0001
 
+// Expression given on the command line, e.g. "x*exp(x)-cos(x)"
+Expression expression;
+int use_expression = 0;
+
 double f(double x)
 {
+    // function: runtime expression, when one was given
+    if (use_expression)
+        return expr_eval(&expression, x, 0.0);
+
     // function: f(x) = x^2 - x - 2
     return x * x - x - 2;
 
@@ -17,11 +27,26 @@ double f(double x)
     // return x * log10(x) - 1.2;
 }
 
+// Print one traced iteration: a, b, x, f(x)
+void print_iteration(const TraceRecord *r)
+{
+    printf("%d\t\t %.6f\t %.6f\t %.6f\t %.6f\t %.6f\n", r->iteration, r->values[0], r->values[1], r->values[2], r->values[3], fabs(r->values[3]));
+}
+
 int main(int argc, char const *argv[])
 {
     double a, b, x, fa, fb, fx; // Initial guesses and function values
     int iter = 0;                // Iteration counter
 
+    // Use the function given as the first argument instead of the built-in one
+    if (argc > 1)
+    {
+        if (expr_compile(&expression, argv[1]) != 0)
+            return 1;
+        use_expression = 1;
+        printf("Function: f(x) = %s\n", argv[1]);
+    }
+
     // Get the initial valid guesses from the user
     while (1)
     {
@@ -49,14 +74,15 @@ int main(int argc, char const *argv[])
     printf("\nFalse Position Method:\n");
     printf("Iteration\t a\t\t b\t\t x\t\t f(x)\t\t |f(x)|\n");
     printf("------------------------------------------------------------------------------------------\n");
+    trace_begin("false-position");
     do
     {
         // Calculate the midpoint
         x = (a * fb - b * fa) / (fb - fa);
         fx = f(x);
 
-        // Print the current iteration values
-        printf("%d\t\t %.6f\t %.6f\t %.6f\t %.6f\t %.6f\n", iter, a, b, x, fx, fabs(fx));
+        // Record the current iteration values
+        TRACE(iter, a, b, x, fx);
 
         // Check if the root is found or if the tolerance is met
         if (fabs(fx) < TOLERANCE || fabs(b - a) < TOLERANCE)
@@ -78,6 +104,10 @@ int main(int argc, char const *argv[])
 
     } while (1);
 
+    // Print the iteration table
+    trace_end();
+    trace_print(print_iteration);
+
     printf("------------------------------------------------------------------------------------------\n");
     // Print the final result
     printf("Root found: x = %.6f, f(x) = %.6f\n", x, fx);
@@ -0,0 +1,230 @@
+// Batched Bisection / False Position solver
+// Solves many independent brackets [a[i], b[i]] in lockstep, a block of lanes at a time.
+// Compile: gcc -O3 -march=native -fopenmp 03-batched-bracket-solver.c -o batched -lm
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#define TOLERANCE 0.0001
+#define MAX_ITERATIONS 1000
+#define LANES 64 // Brackets stepped together; a multiple of the AVX2/AVX-512 width
+
+// Method used to pick the next point inside a bracket
+typedef enum
+{
+    BISECTION = 1,
+    FALSE_POSITION
+} BracketMethod;
+
+// Per-lane result status
+typedef enum
+{
+    BRACKET_CONVERGED = 0, // |f(x)| or |b - a| fell below TOLERANCE
+    BRACKET_INVALID,       // f(a) and f(b) have the same sign
+    BRACKET_MAX_ITERATIONS // MAX_ITERATIONS reached without convergence
+} BracketStatus;
+
+// Vectorizable callable: evaluates fx[i] = f(x[i]) for i = 0 .. n-1
+typedef void (*batch_function)(const double x[], double fx[], int n);
+
+// function: f(x) = x^2 - x - 2, evaluated over a whole block of lanes
+void f_batch(const double x[], double fx[], int n)
+{
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (int i = 0; i < n; i++)
+    {
+        fx[i] = x[i] * x[i] - x[i] - 2;
+
+        // function: f(x) = x - e^-x
+        // fx[i] = x[i] - exp(-x[i]);
+
+        // function: f(x) = x e^x - cos(x)
+        // fx[i] = x[i] * exp(x[i]) - cos(x[i]);
+    }
+}
+
+// Step one block of at most LANES brackets until every lane is done
+static void solve_block(batch_function f, BracketMethod method, const double a_in[], const double b_in[], int n,
+                        double root[], int iterations[], BracketStatus status[])
+{
+    double a[LANES] = {0}, b[LANES] = {0}, fa[LANES], fb[LANES], x[LANES], fx[LANES];
+    int active[LANES]; // 1 while the lane is still iterating (the convergence mask)
+    int remaining = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        a[i] = a_in[i];
+        b[i] = b_in[i];
+    }
+
+    // Get the function values at the initial guesses
+    f(a, fa, n);
+    f(b, fb, n);
+
+    // Check which brackets are valid
+    for (int i = 0; i < n; i++)
+    {
+        active[i] = !(fa[i] * fb[i] > 0);
+        status[i] = active[i] ? BRACKET_MAX_ITERATIONS : BRACKET_INVALID;
+        iterations[i] = 0;
+        root[i] = NAN;
+        remaining += active[i];
+    }
+
+    for (int iter = 0; iter < MAX_ITERATIONS && remaining > 0; iter++)
+    {
+        // Calculate the next point in every lane (inactive lanes are evaluated too and ignored)
+        if (method == BISECTION)
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int i = 0; i < n; i++)
+                x[i] = (a[i] + b[i]) / 2.0;
+        }
+        else
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int i = 0; i < n; i++)
+            {
+                double denom = fb[i] - fa[i];
+                x[i] = denom != 0.0 ? (a[i] * fb[i] - b[i] * fa[i]) / denom : (a[i] + b[i]) / 2.0;
+            }
+        }
+
+        f(x, fx, n);
+
+        // Masked update: converged lanes freeze, the rest shrink their bracket
+        remaining = 0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : remaining)
+#endif
+        for (int i = 0; i < n; i++)
+        {
+            int done = active[i] && (fabs(fx[i]) < TOLERANCE || fabs(b[i] - a[i]) < TOLERANCE);
+            int step = active[i] && !done;
+            int left = fa[i] * fx[i] < 0;
+
+            root[i] = active[i] ? x[i] : root[i];
+            iterations[i] += active[i];
+            status[i] = done ? BRACKET_CONVERGED : status[i];
+
+            b[i] = (step && left) ? x[i] : b[i];
+            fb[i] = (step && left) ? fx[i] : fb[i];
+            a[i] = (step && !left) ? x[i] : a[i];
+            fa[i] = (step && !left) ? fx[i] : fa[i];
+
+            active[i] = step;
+            remaining += step;
+        }
+    }
+}
+
+// Solve count brackets; root[], iterations[] and status[] receive one entry per bracket
+void solve_brackets(batch_function f, BracketMethod method, const double a[], const double b[], int count,
+                    double root[], int iterations[], BracketStatus status[])
+{
+    int blocks = (count + LANES - 1) / LANES;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (int blk = 0; blk < blocks; blk++)
+    {
+        int start = blk * LANES;
+        int n = count - start < LANES ? count - start : LANES;
+        solve_block(f, method, a + start, b + start, n, root + start, iterations + start, status + start);
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Driver code
+int main(int argc, char const *argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 1000000; // Number of brackets
+    if (count <= 0)
+    {
+        printf("Invalid number of brackets.\n");
+        return 1;
+    }
+
+    double *a = malloc(count * sizeof(double));
+    double *b = malloc(count * sizeof(double));
+    double *root = malloc(count * sizeof(double));
+    int *iterations = malloc(count * sizeof(int));
+    BracketStatus *status = malloc(count * sizeof(BracketStatus));
+    if (!a || !b || !root || !iterations || !status)
+    {
+        printf("Memory allocation failed.\n");
+        free(a);
+        free(b);
+        free(root);
+        free(iterations);
+        free(status);
+        return 1;
+    }
+
+    // Random brackets around the root x = 2; every 1000th bracket is made invalid
+    srand(42);
+    for (int i = 0; i < count; i++)
+    {
+        a[i] = 2.0 * rand() / RAND_MAX;
+        b[i] = 2.0 + 3.0 * rand() / RAND_MAX + 1e-3;
+        if (i % 1000 == 999)
+            a[i] = 3.0;
+    }
+
+    const char *names[] = {"Bisection", "False Position"};
+    for (BracketMethod method = BISECTION; method <= FALSE_POSITION; method++)
+    {
+        double start = wall_time();
+        solve_brackets(f_batch, method, a, b, count, root, iterations, status);
+        double elapsed = wall_time() - start;
+
+        int converged = 0, invalid = 0, failed = 0;
+        long total_iterations = 0;
+        double max_error = 0.0;
+        for (int i = 0; i < count; i++)
+        {
+            total_iterations += iterations[i];
+            if (status[i] == BRACKET_CONVERGED)
+            {
+                converged++;
+                if (fabs(root[i] - 2.0) > max_error)
+                    max_error = fabs(root[i] - 2.0);
+            }
+            else if (status[i] == BRACKET_INVALID)
+                invalid++;
+            else
+                failed++;
+        }
+
+        printf("\n%s Method (batched, %d brackets):\n", names[method - 1], count);
+        printf("------------------------------------------------------------\n");
+        printf("Converged: %d, Invalid: %d, Max iterations: %d\n", converged, invalid, failed);
+        printf("Average iterations: %.2f, Max |x - 2|: %.6f\n", (double)total_iterations / count, max_error);
+        printf("Time: %.4f s (%.2f million brackets/s)\n", elapsed, count / elapsed / 1e6);
+        printf("------------------------------------------------------------\n");
+        printf("Root found (bracket 0): x = %.6f after %d iterations\n", root[0], iterations[0]);
+    }
+
+    free(a);
+    free(b);
+    free(root);
+    free(iterations);
+    free(status);
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+// Parallel multi-root scanner
+// Splits [lo, hi] into chunks across threads, finds every sign change on a fine grid and
+// refines each bracket with the bisection or false position kernel. The grid is sampled in
+// blocks, so a runtime expression is evaluated EXPR_LANES points at a time (expr_eval_batch).
+// Compile: gcc -O2 -fopenmp 04-multi-root-scanner.c -o scanner -lm
+// Usage:   ./scanner ["expression" [lo hi [samples]]]
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../common/expression.h"
+
+#define TOLERANCE 0.0001
+#define MAX_ITERATIONS 1000
+#define CHUNKS_PER_THREAD 8 // Over-decomposition so threads stay balanced
+#define SCAN_BLOCK 256      // Grid intervals sampled per batch
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#endif
+
+// Method used to refine each bracket
+typedef enum
+{
+    BISECTION = 1,
+    FALSE_POSITION
+} BracketMethod;
+
+// Growable list of roots
+typedef struct
+{
+    double *roots;
+    int count;
+    int capacity;
+} RootList;
+
+// Expression given on the command line, e.g. "x*exp(x)-cos(x)"
+Expression expression;
+int use_expression = 0;
+
+double f(double x)
+{
+    // function: runtime expression, when one was given
+    if (use_expression)
+        return expr_eval(&expression, x, 0.0);
+
+    // function: f(x) = sin(x), roots at multiples of pi
+    return sin(x);
+}
+
+// fx[i] = f(x[i]) for i = 0 .. n-1, with the batch interpreter for a runtime expression
+void f_batch(const double x[], double fx[], int n)
+{
+    if (use_expression)
+    {
+        expr_eval_batch(&expression, x, NULL, fx, n);
+        return;
+    }
+    for (int i = 0; i < n; i++)
+        fx[i] = f(x[i]);
+}
+
+// Append a root to the list, growing it as needed
+static int root_list_add(RootList *list, double root)
+{
+    if (list->count == list->capacity)
+    {
+        int capacity = list->capacity ? 2 * list->capacity : 16;
+        double *roots = realloc(list->roots, capacity * sizeof(double));
+        if (!roots)
+            return -1;
+        list->roots = roots;
+        list->capacity = capacity;
+    }
+    list->roots[list->count++] = root;
+    return 0;
+}
+
+// Bisection kernel on a valid bracket (fa * fb < 0)
+double bisection(double (*func)(double), double a, double b, double fa)
+{
+    double x = a, fx;
+
+    for (int iter = 0; iter < MAX_ITERATIONS; iter++)
+    {
+        x = (a + b) / 2.0;
+        fx = func(x);
+
+        if (fabs(fx) < TOLERANCE || fabs(b - a) < TOLERANCE)
+            break;
+
+        if (fa * fx < 0)
+            b = x;
+        else
+        {
+            a = x;
+            fa = fx;
+        }
+    }
+    return x;
+}
+
+// False position kernel on a valid bracket (fa * fb < 0)
+double false_position(double (*func)(double), double a, double b, double fa, double fb)
+{
+    double x = a, fx;
+
+    for (int iter = 0; iter < MAX_ITERATIONS; iter++)
+    {
+        x = (a * fb - b * fa) / (fb - fa);
+        fx = func(x);
+
+        if (fabs(fx) < TOLERANCE || fabs(b - a) < TOLERANCE)
+            break;
+
+        if (fa * fx < 0)
+        {
+            b = x;
+            fb = fx;
+        }
+        else
+        {
+            a = x;
+            fa = fx;
+        }
+    }
+    return x;
+}
+
+static int compare_doubles(const void *p, const void *q)
+{
+    double a = *(const double *)p, b = *(const double *)q;
+    return (a > b) - (a < b);
+}
+
+// Find all roots of func in [lo, hi] using samples grid intervals; the grid is sampled with
+// batch (the same function, n points per call) and the brackets are refined with func.
+// Returns the number of roots and stores a sorted, de-duplicated array in *roots (free it).
+int scan_roots(double (*func)(double), void (*batch)(const double[], double[], int), double lo, double hi,
+               long samples, BracketMethod method, double **roots)
+{
+    int chunks = omp_get_max_threads() * CHUNKS_PER_THREAD;
+    if (chunks > samples)
+        chunks = (int)samples;
+
+    RootList *partial = calloc(chunks, sizeof(RootList));
+    RootList all = {NULL, 0, 0};
+    double h = (hi - lo) / samples;
+    int failed = 0;
+
+    if (!partial)
+        return -1;
+
+    // Each chunk scans grid intervals [start, end) and refines its own brackets
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) reduction(| : failed)
+#endif
+    for (int c = 0; c < chunks; c++)
+    {
+        long start = samples * c / chunks;
+        long end = samples * (c + 1) / chunks;
+        double x[SCAN_BLOCK + 1], fx[SCAN_BLOCK + 1];
+
+        for (long first = start; first < end; first += SCAN_BLOCK)
+        {
+            // Grid points first .. first + m, both ends of the block's m intervals
+            int m = end - first < SCAN_BLOCK ? (int)(end - first) : SCAN_BLOCK;
+            for (int k = 0; k <= m; k++)
+                x[k] = (first + k == samples) ? hi : lo + (first + k) * h;
+            batch(x, fx, m + 1);
+
+            for (int k = 0; k < m; k++)
+            {
+                double a = x[k], fa = fx[k], b = x[k + 1], fb = fx[k + 1];
+                long i = first + k;
+
+                if (fa == 0.0)
+                    failed |= root_list_add(&partial[c], a);
+                else if (fa * fb < 0)
+                {
+                    double root = method == BISECTION ? bisection(func, a, b, fa) : false_position(func, a, b, fa, fb);
+                    failed |= root_list_add(&partial[c], root);
+                }
+                else if (fb == 0.0 && i + 1 == samples)
+                    failed |= root_list_add(&partial[c], b);
+            }
+        }
+    }
+
+    // Merge, sort and drop duplicates (roots closer than the tolerance)
+    for (int c = 0; c < chunks; c++)
+    {
+        for (int i = 0; i < partial[c].count; i++)
+            failed |= root_list_add(&all, partial[c].roots[i]);
+        free(partial[c].roots);
+    }
+    free(partial);
+
+    if (failed)
+    {
+        free(all.roots);
+        return -1;
+    }
+
+    qsort(all.roots, all.count, sizeof(double), compare_doubles);
+    int unique = 0;
+    for (int i = 0; i < all.count; i++)
+    {
+        if (unique == 0 || all.roots[i] - all.roots[unique - 1] > 2 * TOLERANCE)
+            all.roots[unique++] = all.roots[i];
+    }
+
+    *roots = all.roots;
+    return unique;
+}
+
+// Wall clock time in seconds
+static double wall_time(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char const *argv[])
+{
+    double lo = -20.0, hi = 20.0;
+    long samples = 10000000;
+
+    // Use the function given as the first argument instead of the built-in one
+    if (argc > 1)
+    {
+        if (expr_compile(&expression, argv[1]) != 0)
+            return 1;
+        use_expression = 1;
+        printf("Function: f(x) = %s\n", argv[1]);
+    }
+    if (argc > 3)
+    {
+        lo = atof(argv[2]);
+        hi = atof(argv[3]);
+    }
+    if (argc > 4)
+        samples = atol(argv[4]);
+    if (!(hi > lo) || samples <= 0)
+    {
+        printf("Invalid interval or number of samples.\n");
+        return 1;
+    }
+
+    const char *names[] = {"Bisection", "False Position"};
+    for (BracketMethod method = BISECTION; method <= FALSE_POSITION; method++)
+    {
+        double *roots;
+        double start = wall_time();
+        int count = scan_roots(f, f_batch, lo, hi, samples, method, &roots);
+        double elapsed = wall_time() - start;
+
+        if (count < 0)
+        {
+            printf("Memory allocation failed.\n");
+            return 1;
+        }
+
+        printf("\n%s scan of [%g, %g] with %ld samples on %d threads:\n", names[method - 1], lo, hi, samples,
+               omp_get_max_threads());
+        printf("------------------------------------------------------------\n");
+        for (int i = 0; i < count; i++)
+            printf("Root %d: x = %.6f, f(x) = %.6f\n", i + 1, roots[i], f(roots[i]));
+        printf("------------------------------------------------------------\n");
+        printf("%d roots found in %.4f s\n", count, elapsed);
+
+        free(roots);
+    }
+
+    return 0;
+}
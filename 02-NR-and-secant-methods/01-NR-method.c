@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/trace.h"
 
 #define TOLERANCE 0.001
 #define MAX_ITERATIONS 1000
@@ -16,17 +17,26 @@ double f_prime(double x)
     return 2 * x - 1; // Derivative of the function: f'(x) = 2x - 1
 }
 
+// Print one traced iteration: x, f(x), f'(x)
+void print_iteration(const TraceRecord *r)
+{
+    printf("%d \t\t%.6lf, \t%.6lf, \t%.6lf\n", r->iteration, r->values[0], r->values[1], r->values[2]);
+}
+
 // Newton-Raphson method
 double newton_raphson(double initial_guess)
 {
     double x0 = initial_guess;
     double x1;
     int iterations = 0;
+    double root = NAN;
+    const char *message = "Maximum iterations reached. No solution found.\n";
 
     // Print the header for the table
     printf("\nNewton-Raphson Method\n");
     printf("Iteration\t x\t\t f(x)\t\t f'(x)\n");
     printf("----------------------------------------------------------\n");
+    trace_begin("newton-raphson");
 
     while (iterations < MAX_ITERATIONS)
     {
@@ -35,13 +45,15 @@ double newton_raphson(double initial_guess)
 
         if (fabs(fx0) < TOLERANCE)
         {
-            return x0; // Root found
+            root = x0; // Root found
+            message = NULL;
+            break;
         }
 
         if (fabs(fpx0) < TOLERANCE)
         {
-            printf("Derivative is too small. No solution found.\n");
-            return NAN; // Derivative is too small, no solution found
+            message = "Derivative is too small. No solution found.\n";
+            break; // Derivative is too small, no solution found
         }
 
         x1 = x0 - fx0 / fpx0; // Update the guess
@@ -49,12 +61,17 @@ double newton_raphson(double initial_guess)
         x0 = x1; // Update the guess for the next iteration
         iterations++;
 
-        // Print the current details in table format
-        printf("%d \t\t%.6lf, \t%.6lf, \t%.6lf\n", iterations, x0, fx0, fpx0);
+        // Record the current details for the table
+        TRACE(iterations, x0, fx0, fpx0);
     }
 
-    printf("Maximum iterations reached. No solution found.\n");
-    return NAN; // Maximum iterations reached, no solution found
+    // Print the table
+    trace_end();
+    trace_print(print_iteration);
+
+    if (message)
+        printf("%s", message);
+    return root; // NAN if no solution was found
 }
 
 // Driver method
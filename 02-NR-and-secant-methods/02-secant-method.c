@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/trace.h"
 
 #define TOLERANCE 0.001
 #define MAX_ITERATIONS 1000
@@ -10,6 +11,12 @@ double f(double x)
     return x * x - x - 1; // Example function: f(x) = x^2 - x - 1
 }
 
+// Print one traced iteration: x0, x1, f(x0), f(x1), x2, f(x2)
+void print_iteration(const TraceRecord *r)
+{
+    printf("%d \t\t%.6lf\t%.6lf\t%.6lf\t%.6lf\t%.6lf\t%.6lf\n", r->iteration, r->values[0], r->values[1], r->values[2], r->values[3], r->values[4], r->values[5]);
+}
+
 // Secant method
 double secant(double a, double b)
 {
@@ -17,11 +24,13 @@ double secant(double a, double b)
     double x1 = b;
     double x2;
     int iterations = 0;
+    double root = NAN;
 
     // Print the header for the table
     printf("\nSecant Method\n");
     printf("Iteration\t x0\t\t x1\t\t f(x0)\t\t f(x1)\t\t x2\t\t f(x2)\n");
     printf("-----------------------------------------------------------------------------------------------------------\n");
+    trace_begin("secant");
 
     while (iterations < MAX_ITERATIONS)
     {
@@ -30,7 +39,8 @@ double secant(double a, double b)
 
         if (fabs(fx1) < TOLERANCE)
         {
-            return x1; // Root found
+            root = x1; // Root found
+            break;
         }
 
         x2 = (x0 * fx1 - x1 * fx0) / (fx1 - fx0); // Update the guess
@@ -39,12 +49,17 @@ double secant(double a, double b)
         x1 = x2; // Update the guess for the next iteration
         iterations++;
 
-        // Print the current details in table format
-        printf("%d \t\t%.6lf\t%.6lf\t%.6lf\t%.6lf\t%.6lf\t%.6lf\n", iterations, x0, x1, fx0, fx1, x2, f(x2));
+        // Record the current details for the table (f(x2) is only evaluated when tracing)
+        TRACE(iterations, x0, x1, fx0, fx1, x2, f(x2));
     }
 
-    printf("Maximum iterations reached. No solution found.\n");
-    return NAN; // Maximum iterations reached, no solution found
+    // Print the table
+    trace_end();
+    trace_print(print_iteration);
+
+    if (isnan(root))
+        printf("Maximum iterations reached. No solution found.\n");
+    return root; // NAN if maximum iterations reached
 }
 
 // Driver method
@@ -0,0 +1,150 @@
+// Newton-Raphson method with forward-mode automatic differentiation
+// f is written once with dual numbers; f'(x) comes out of the same evaluation,
+// so there is no hand-written f_prime() to keep in sync.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../common/dual.h"
+
+#define TOLERANCE 0.001
+#define MAX_ITERATIONS 1000
+
+// Calculate the value and derivative of the function
+Dual f(Dual x)
+{
+    // Example function: f(x) = x^2 - x - 1
+    return dual_add_c(dual_sub(dual_mul(x, x), x), -1.0);
+
+    // Example function: f(x) = x e^x - cos(x)
+    // return dual_sub(dual_mul(x, dual_exp(x)), dual_cos(x));
+}
+
+// Same function on hyper-dual numbers (value, first and second derivative)
+HyperDual f_hyper(HyperDual x)
+{
+    return hyper_add_c(hyper_sub(hyper_mul(x, x), x), -1.0);
+}
+
+// Newton-Raphson method: returns the root (NAN on failure) and the iteration count
+double newton_raphson(double initial_guess, int *iterations)
+{
+    double x0 = initial_guess;
+
+    for (*iterations = 0; *iterations < MAX_ITERATIONS; (*iterations)++)
+    {
+        Dual fx0 = f(dual_var(x0)); // f(x0) and f'(x0) in one pass
+
+        if (fabs(fx0.val) < TOLERANCE)
+            return x0; // Root found
+
+        if (fabs(fx0.der) < TOLERANCE)
+            return NAN; // Derivative is too small, no solution found
+
+        x0 = x0 - fx0.val / fx0.der; // Update the guess
+    }
+
+    return NAN; // Maximum iterations reached, no solution found
+}
+
+// Halley's method: uses f'' from the hyper-dual pass for cubic convergence
+double halley(double initial_guess, int *iterations)
+{
+    double x0 = initial_guess;
+
+    for (*iterations = 0; *iterations < MAX_ITERATIONS; (*iterations)++)
+    {
+        HyperDual fx0 = f_hyper(hyper_var(x0));
+
+        if (fabs(fx0.val) < TOLERANCE)
+            return x0;
+
+        double denom = 2 * fx0.d1 * fx0.d1 - fx0.val * fx0.d2;
+        if (fabs(denom) < TOLERANCE)
+            return NAN;
+
+        x0 = x0 - 2 * fx0.val * fx0.d1 / denom;
+    }
+
+    return NAN;
+}
+
+// Batched Newton-Raphson: solves one problem per initial guess, in parallel
+void newton_raphson_batch(const double initial_guess[], double root[], int iterations[], int n)
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n; i++)
+    {
+        root[i] = newton_raphson(initial_guess[i], &iterations[i]);
+    }
+}
+
+// Driver method
+int main(int argc, char const *argv[])
+{
+    double initial_guess;
+    int iterations;
+
+    printf("Enter an initial guess: ");
+    if (scanf("%lf", &initial_guess) != 1)
+        return 1;
+
+    // Single solve, printed in the same table format as 01-NR-method.c
+    printf("\nNewton-Raphson Method (automatic differentiation)\n");
+    printf("Iteration\t x\t\t f(x)\t\t f'(x)\n");
+    printf("----------------------------------------------------------\n");
+    double x0 = initial_guess;
+    for (int i = 0; i < MAX_ITERATIONS; i++)
+    {
+        Dual fx0 = f(dual_var(x0));
+        if (fabs(fx0.val) < TOLERANCE || fabs(fx0.der) < TOLERANCE)
+            break;
+        x0 = x0 - fx0.val / fx0.der;
+        printf("%d \t\t%.6lf, \t%.6lf, \t%.6lf\n", i + 1, x0, fx0.val, fx0.der);
+    }
+    printf("----------------------------------------------------------\n");
+
+    double root = newton_raphson(initial_guess, &iterations);
+    if (!isnan(root))
+        printf("Newton-Raphson: root = %lf after %d iterations\n", root, iterations);
+    else
+        printf("Newton-Raphson: no root found.\n");
+
+    root = halley(initial_guess, &iterations);
+    if (!isnan(root))
+        printf("Halley:         root = %lf after %d iterations\n", root, iterations);
+    else
+        printf("Halley:         no root found.\n");
+
+    // Batched solve over a range of initial guesses
+    int n = 1000000;
+    double *guess = malloc(n * sizeof(double));
+    double *roots = malloc(n * sizeof(double));
+    int *iters = malloc(n * sizeof(int));
+    if (!guess || !roots || !iters)
+    {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    for (int i = 0; i < n; i++)
+        guess[i] = -10.0 + 20.0 * i / n;
+
+    newton_raphson_batch(guess, roots, iters, n);
+
+    int failed = 0;
+    long total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        failed += isnan(roots[i]);
+        total += iters[i];
+    }
+    printf("\nBatched Newton-Raphson over %d guesses in [-10, 10]:\n", n);
+    printf("Average iterations: %.2f, failed: %d\n", (double)total / n, failed);
+
+    free(guess);
+    free(roots);
+    free(iters);
+
+    return 0;
+}
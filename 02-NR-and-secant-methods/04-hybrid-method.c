@@ -0,0 +1,325 @@
+// Safeguarded hybrid root finder
+// Combines inverse quadratic interpolation, secant, Illinois-modified regula falsi and
+// bisection inside a bracket (in the style of Brent's method). Every step keeps the root
+// bracketed, and the total number of f evaluations never exceeds the given budget.
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#define TOLERANCE 0.0001
+#define MAX_EVALUATIONS 100
+
+// Result status of the hybrid solver
+typedef enum
+{
+    HYBRID_CONVERGED = 0, // Bracket width fell below the tolerance or f(x) == 0
+    HYBRID_INVALID,       // f(a) and f(b) have the same sign
+    HYBRID_BUDGET         // Evaluation budget exhausted; root holds the best estimate (NAN when max_evaluations < 2)
+} HybridStatus;
+
+// Kinds of step taken by the solver
+typedef enum
+{
+    STEP_BISECTION = 0,
+    STEP_ILLINOIS,
+    STEP_SECANT,
+    STEP_IQI,
+    STEP_KINDS
+} StepKind;
+
+// Result of a hybrid solve
+typedef struct
+{
+    double root;           // Best root estimate
+    double froot;          // f(root)
+    int evaluations;       // Total calls to f
+    int steps[STEP_KINDS]; // Number of steps of each kind
+    HybridStatus status;
+} HybridResult;
+
+// Calculatet the value of the function
+double f(double x)
+{
+    return x * x - x - 1; // Example function: f(x) = x^2 - x - 1
+}
+
+// Hybrid method on the bracket [a, b], using at most max_evaluations calls to func
+HybridResult hybrid_root(double (*func)(double), double a, double b, double tol, int max_evaluations)
+{
+    HybridResult result = {NAN, NAN, 0, {0}, HYBRID_INVALID};
+    double fa, fb, fc, c, d, e;
+    double widths[3] = {INFINITY, INFINITY, INFINITY}; // Bracket widths of the last three steps
+    int retained = 0; // Consecutive steps in which the contrapoint c was kept (Illinois)
+
+    // The bracket alone takes two evaluations
+    if (max_evaluations < 2)
+    {
+        result.status = HYBRID_BUDGET;
+        return result;
+    }
+
+    fa = func(a);
+    fb = func(b);
+    result.evaluations = 2;
+
+    if (fa * fb > 0)
+        return result;
+
+    // c is the contrapoint: f(b) and f(c) always have opposite signs
+    c = a;
+    fc = fa;
+    d = e = b - a;
+
+    while (1)
+    {
+        if (fb * fc > 0)
+        {
+            // The new point crossed the root; the previous iterate becomes the contrapoint
+            c = a;
+            fc = fa;
+            d = e = b - a;
+            retained = 0;
+        }
+        else
+        {
+            retained++;
+        }
+
+        // Keep b as the best estimate
+        if (fabs(fc) < fabs(fb))
+        {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        double tol1 = 2.0 * DBL_EPSILON * fabs(b) + 0.5 * tol;
+        double xm = 0.5 * (c - b);
+
+        if (fabs(xm) <= tol1 || fb == 0.0)
+        {
+            result.status = HYBRID_CONVERGED;
+            break;
+        }
+        if (result.evaluations >= max_evaluations)
+        {
+            result.status = HYBRID_BUDGET;
+            break;
+        }
+
+        // Fall back to bisection if the bracket has not halved over the last two steps
+        widths[2] = widths[1];
+        widths[1] = widths[0];
+        widths[0] = fabs(c - b);
+        int stalled = widths[0] > 0.5 * widths[2];
+
+        StepKind kind = STEP_BISECTION;
+
+        if (!stalled && retained >= 2)
+        {
+            // One-sided convergence: Illinois step, halving f at the retained contrapoint
+            double fc_scaled = ldexp(fc, -(retained - 1));
+            double step = -fb * (c - b) / (fc_scaled - fb);
+            if (fabs(step) > tol1 && fabs(step) < fabs(2.0 * xm))
+            {
+                d = e = step;
+                kind = STEP_ILLINOIS;
+            }
+        }
+        else if (!stalled && fabs(e) >= tol1 && fabs(fa) > fabs(fb))
+        {
+            // Try interpolation through the last points
+            double p, q, r, s = fb / fa;
+
+            if (a == c)
+            {
+                // Secant step
+                p = 2.0 * xm * s;
+                q = 1.0 - s;
+                kind = STEP_SECANT;
+            }
+            else
+            {
+                // Inverse quadratic interpolation step
+                q = fa / fc;
+                r = fb / fc;
+                p = s * (2.0 * xm * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+                kind = STEP_IQI;
+            }
+
+            if (p > 0)
+                q = -q;
+            else
+                p = -p;
+
+            // Accept only if the step stays well inside the bracket and keeps shrinking
+            if (2.0 * p < fmin(3.0 * xm * q - fabs(tol1 * q), fabs(e * q)))
+            {
+                e = d;
+                d = p / q;
+            }
+            else
+            {
+                kind = STEP_BISECTION;
+            }
+        }
+
+        if (kind == STEP_BISECTION)
+        {
+            d = xm;
+            e = d;
+        }
+
+        result.steps[kind]++;
+
+        // Move to the new point
+        a = b;
+        fa = fb;
+        if (fabs(d) > tol1)
+            b += d;
+        else
+            b += xm > 0 ? tol1 : -tol1;
+        fb = func(b);
+        result.evaluations++;
+    }
+
+    result.root = b;
+    result.froot = fb;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Comparison against the plain methods, counting function evaluations
+// ---------------------------------------------------------------------------
+
+static int evaluation_count = 0;
+static double (*counted_target)(double);
+
+// Wrapper that counts calls to the target function
+static double counted(double x)
+{
+    evaluation_count++;
+    return counted_target(x);
+}
+
+// f(x) = x^10 - 1: regula falsi stalls with one endpoint fixed
+static double steep(double x) { return pow(x, 10) - 1; }
+
+// f(x) = x e^x - cos(x)
+static double transcendental(double x) { return x * exp(x) - cos(x); }
+
+// f(x) = (x - 1)^3: flat near the root
+static double flat(double x) { return (x - 1) * (x - 1) * (x - 1); }
+
+// Plain bisection, returns the number of evaluations used
+static int bisection_evaluations(double (*func)(double), double a, double b, double tol)
+{
+    double fa = func(a);
+    int evaluations = 2;
+    func(b);
+    while (fabs(b - a) > tol && evaluations < 10000)
+    {
+        double x = (a + b) / 2, fx = func(x);
+        evaluations++;
+        if (fx == 0)
+            break;
+        if (fa * fx < 0)
+            b = x;
+        else
+        {
+            a = x;
+            fa = fx;
+        }
+    }
+    return evaluations;
+}
+
+// Plain false position, returns the number of evaluations used
+static int false_position_evaluations(double (*func)(double), double a, double b, double tol)
+{
+    double fa = func(a), fb = func(b), x_old = a;
+    int evaluations = 2;
+    while (evaluations < 10000)
+    {
+        double x = (a * fb - b * fa) / (fb - fa), fx = func(x);
+        evaluations++;
+        if (fabs(x - x_old) < tol || fx == 0)
+            break;
+        x_old = x;
+        if (fa * fx < 0)
+        {
+            b = x;
+            fb = fx;
+        }
+        else
+        {
+            a = x;
+            fa = fx;
+        }
+    }
+    return evaluations;
+}
+
+// Driver method
+int main(int argc, char const *argv[])
+{
+    double a, b;
+
+    // Get a valid bracket from the user
+    do
+    {
+        printf("Enter initial guesses (a b): ");
+        if (scanf("%lf %lf", &a, &b) != 2)
+            return 1;
+
+        if (f(a) * f(b) > 0)
+        {
+            printf("Invalid initial guesses. f(a) and f(b) must have opposite signs.\n");
+            continue;
+        }
+        printf("Initial guesses accepted: %lf, %lf\n", a, b);
+        break;
+    } while (1);
+
+    HybridResult r = hybrid_root(f, a, b, TOLERANCE, MAX_EVALUATIONS);
+    printf("\nHybrid Method\n");
+    printf("-----------------------------------------------------------------\n");
+    printf("Root: %lf, f(root) = %lf\n", r.root, r.froot);
+    printf("Evaluations: %d (budget %d)\n", r.evaluations, MAX_EVALUATIONS);
+    printf("Steps: bisection %d, Illinois %d, secant %d, IQI %d\n", r.steps[STEP_BISECTION],
+           r.steps[STEP_ILLINOIS], r.steps[STEP_SECANT], r.steps[STEP_IQI]);
+    printf("Status: %s\n", r.status == HYBRID_CONVERGED ? "converged" : r.status == HYBRID_BUDGET ? "budget exhausted" : "invalid bracket");
+
+    // Evaluation counts on harder functions
+    struct
+    {
+        const char *name;
+        double (*func)(double);
+        double a, b;
+    } tests[] = {
+        {"x^10 - 1", steep, 0.0, 1.3},
+        {"x e^x - cos(x)", transcendental, 0.0, 1.0},
+        {"(x - 1)^3", flat, 0.0, 1.7},
+    };
+
+    printf("\nFunction evaluations to reach |b - a| < %g\n", TOLERANCE);
+    printf("Function\t\t Bisection\t False Position\t Hybrid\n");
+    printf("-----------------------------------------------------------------\n");
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        counted_target = tests[i].func;
+        evaluation_count = 0;
+        HybridResult h = hybrid_root(counted, tests[i].a, tests[i].b, TOLERANCE, MAX_EVALUATIONS);
+        printf("%-16s\t %d\t\t %d\t\t %d (root %.6f)\n", tests[i].name,
+               bisection_evaluations(tests[i].func, tests[i].a, tests[i].b, TOLERANCE),
+               false_position_evaluations(tests[i].func, tests[i].a, tests[i].b, TOLERANCE),
+               evaluation_count, h.root);
+    }
+    printf("-----------------------------------------------------------------\n");
+
+    return 0;
+}
@@ -0,0 +1,395 @@
+// Newton basin mapping
+// Runs Newton-Raphson (and the secant method) from every point of a grid of starting values
+// and records which root each start converges to and how many iterations it took.
+//   1-D: real starts in [lo, hi] for f(x) (derivative by dual numbers)
+//   2-D: complex starts in a rectangle for a polynomial p(z)
+// The result is written as a compact binary raster:
+//   char magic[8] = "NRBASIN1", int32 width, int32 height, int32 roots,
+//   double roots[2 * roots] (re, im), then width * height pixels of
+//   uint8 root index (255 = no convergence) and uint8 iterations.
+// The 1-D maps are written in the same format with height 1.
+// Compile: gcc -O3 -march=native -fopenmp 05-newton-basins.c -o basins -lm
+// Usage:   ./basins [resolution [output prefix]]
+//          writes <prefix>-newton.bin, <prefix>-secant.bin (1-D) and <prefix>-complex.bin (2-D)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "../common/dual.h"
+
+#define TOLERANCE 1e-10
+#define RESIDUAL 1e-8 // |f(x)| required at convergence, so a stalled step is not taken for a root
+#define MAX_ITERATIONS 64
+#define MAX_ROOTS 32
+#define NO_ROOT 255
+#define LANES 16 // Starts stepped together in the complex kernel
+
+// One grid cell of the raster
+typedef struct
+{
+    uint8_t root;       // Index into the root list, NO_ROOT if not converged
+    uint8_t iterations; // Iterations used (clamped to 255)
+} BasinCell;
+
+// Roots found so far (real part, imaginary part)
+typedef struct
+{
+    int count;
+    double re[MAX_ROOTS];
+    double im[MAX_ROOTS];
+} RootSet;
+
+// ---------------------------------------------------------------------------
+// 1-D: real function
+// ---------------------------------------------------------------------------
+
+// Calculate the value and derivative of the function: f(x) = x^3 - 2x + 2
+Dual f(Dual x)
+{
+    return dual_add_c(dual_sub(dual_mul(x, dual_mul(x, x)), dual_scale(x, 2.0)), 2.0);
+}
+
+// Index of the root closest to (re, im) within tol, or -1
+static int find_root(const RootSet *set, double re, double im, double tol)
+{
+    for (int k = 0; k < set->count; k++)
+    {
+        if (fabs(set->re[k] - re) < tol && fabs(set->im[k] - im) < tol)
+            return k;
+    }
+    return -1;
+}
+
+// Index of the root at (re, im), adding it if it is new; -1 when the set is full.
+// Threads may call this while others read the set: an entry is complete before count
+// is raised to include it.
+static int add_root(RootSet *set, double re, double im, double tol)
+{
+    int k, count;
+#ifdef _OPENMP
+#pragma omp atomic read seq_cst
+#endif
+    count = set->count;
+    for (k = 0; k < count; k++)
+    {
+        if (fabs(set->re[k] - re) < tol && fabs(set->im[k] - im) < tol)
+            return k;
+    }
+
+#ifdef _OPENMP
+#pragma omp critical(basin_roots)
+#endif
+    {
+        k = find_root(set, re, im, tol);
+        if (k < 0 && set->count < MAX_ROOTS)
+        {
+            k = set->count;
+            set->re[k] = re;
+            set->im[k] = im;
+#ifdef _OPENMP
+#pragma omp atomic write seq_cst
+#endif
+            set->count = k + 1;
+        }
+    }
+    return k;
+}
+
+// Newton-Raphson from x0; returns the converged x (small step and small |f(x)|) or NAN
+static double newton_real(double x0, int *iterations)
+{
+    for (*iterations = 0; *iterations < MAX_ITERATIONS; (*iterations)++)
+    {
+        Dual fx = f(dual_var(x0));
+        if (fx.der == 0.0)
+            return NAN;
+        double step = fx.val / fx.der;
+        x0 -= step;
+        if (fabs(step) < TOLERANCE && fabs(f(dual_const(x0)).val) < RESIDUAL)
+            return x0;
+    }
+    return NAN;
+}
+
+// Secant method from x0 and x0 + delta; returns the converged x (small step and small |f(x)|) or NAN
+static double secant_real(double x0, double delta, int *iterations)
+{
+    double x1 = x0 + delta;
+    double f0 = f(dual_const(x0)).val, f1 = f(dual_const(x1)).val;
+
+    for (*iterations = 0; *iterations < MAX_ITERATIONS; (*iterations)++)
+    {
+        if (f1 == f0)
+            return NAN;
+        double x2 = (x0 * f1 - x1 * f0) / (f1 - f0);
+        x0 = x1;
+        f0 = f1;
+        x1 = x2;
+        f1 = f(dual_const(x1)).val;
+        if (fabs(x1 - x0) < TOLERANCE && fabs(f1) < RESIDUAL)
+            return x1;
+    }
+    return NAN;
+}
+
+// Map every start of the 1-D grid. A coarse pass finds the roots first so their order
+// does not depend on thread timing; roots seen only in the full pass are added there.
+void basins_real(double lo, double hi, size_t width, int use_secant, RootSet *roots, BasinCell cells[])
+{
+    int iterations;
+    double h = (hi - lo) / (width - 1);
+
+    // Discovery pass on a coarse subgrid
+    roots->count = 0;
+    for (size_t i = 0; i < width; i += 64)
+    {
+        double x = use_secant ? secant_real(lo + i * h, 1e-3, &iterations) : newton_real(lo + i * h, &iterations);
+        if (!isnan(x))
+            add_root(roots, x, 0.0, 1e-6);
+    }
+
+    // Classification pass
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 4096) private(iterations)
+#endif
+    for (size_t i = 0; i < width; i++)
+    {
+        double x = use_secant ? secant_real(lo + i * h, 1e-3, &iterations) : newton_real(lo + i * h, &iterations);
+        int k = isnan(x) ? -1 : add_root(roots, x, 0.0, 1e-6);
+        cells[i].root = k < 0 ? NO_ROOT : (uint8_t)k;
+        cells[i].iterations = (uint8_t)(iterations > 255 ? 255 : iterations);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 2-D: complex polynomial p(z) = sum coef[k] z^k
+// ---------------------------------------------------------------------------
+
+// Newton from a block of complex starts, stepped in lockstep with a convergence mask
+static void newton_complex_block(const double coef[], int degree, const double zr0[], const double zi0[], int n,
+                                 double zr_out[], double zi_out[], int iterations[])
+{
+    double zr[LANES], zi[LANES];
+    int active[LANES];
+
+    for (int l = 0; l < LANES; l++)
+    {
+        zr[l] = l < n ? zr0[l] : 0.0;
+        zi[l] = l < n ? zi0[l] : 0.0;
+        active[l] = l < n;
+        iterations[l] = 0;
+    }
+
+    for (int it = 0; it < MAX_ITERATIONS; it++)
+    {
+        int remaining = 0;
+
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : remaining)
+#endif
+        for (int l = 0; l < LANES; l++)
+        {
+            // Horner for p(z) and p'(z)
+            double pr = coef[degree], pi = 0.0, dr = 0.0, di = 0.0;
+            for (int k = degree - 1; k >= 0; k--)
+            {
+                double ndr = dr * zr[l] - di * zi[l] + pr;
+                double ndi = dr * zi[l] + di * zr[l] + pi;
+                double npr = pr * zr[l] - pi * zi[l] + coef[k];
+                double npi = pr * zi[l] + pi * zr[l];
+                dr = ndr;
+                di = ndi;
+                pr = npr;
+                pi = npi;
+            }
+
+            // step = p / p'
+            double den = dr * dr + di * di;
+            double sr = (pr * dr + pi * di) / den;
+            double si = (pi * dr - pr * di) / den;
+            // Converged on a small step and a small |p(z)|; NaN also stops (and gives no root)
+            int done = !(sr * sr + si * si >= TOLERANCE * TOLERANCE) && !(pr * pr + pi * pi >= RESIDUAL * RESIDUAL);
+
+            zr[l] = active[l] ? zr[l] - sr : zr[l];
+            zi[l] = active[l] ? zi[l] - si : zi[l];
+            iterations[l] += active[l];
+            active[l] = active[l] && !done;
+            remaining += active[l];
+        }
+
+        if (remaining == 0)
+            break;
+    }
+
+    for (int l = 0; l < n; l++)
+    {
+        zr_out[l] = active[l] ? NAN : zr[l];
+        zi_out[l] = active[l] ? NAN : zi[l];
+    }
+}
+
+// Map the complex grid [re_lo, re_hi] x [im_lo, im_hi] of width x height starts
+void basins_complex(const double coef[], int degree, double re_lo, double re_hi, double im_lo, double im_hi,
+                    int width, int height, RootSet *roots, BasinCell cells[])
+{
+    double hr = (re_hi - re_lo) / (width - 1), hi = (im_hi - im_lo) / (height - 1);
+
+    // Discovery pass on a coarse subgrid
+    roots->count = 0;
+    for (int y = 0; y < height; y += 32)
+    {
+        for (int x = 0; x < width; x += 32)
+        {
+            double zr0 = re_lo + x * hr, zi0 = im_lo + y * hi, zr[LANES], zi[LANES];
+            int iterations[LANES];
+            newton_complex_block(coef, degree, &zr0, &zi0, 1, zr, zi, iterations);
+            if (!isnan(zr[0]))
+                add_root(roots, zr[0], zi[0], 1e-6);
+        }
+    }
+
+    // Classification pass: one row per task, LANES starts per block
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int y = 0; y < height; y++)
+    {
+        double zr0[LANES], zi0[LANES], zr[LANES], zi[LANES];
+        int iterations[LANES];
+
+        for (int x0 = 0; x0 < width; x0 += LANES)
+        {
+            int n = width - x0 < LANES ? width - x0 : LANES;
+            for (int l = 0; l < n; l++)
+            {
+                zr0[l] = re_lo + (x0 + l) * hr;
+                zi0[l] = im_lo + y * hi;
+            }
+            newton_complex_block(coef, degree, zr0, zi0, n, zr, zi, iterations);
+            for (int l = 0; l < n; l++)
+            {
+                int k = isnan(zr[l]) ? -1 : add_root(roots, zr[l], zi[l], 1e-6);
+                BasinCell *cell = &cells[(size_t)y * width + x0 + l];
+                cell->root = k < 0 ? NO_ROOT : (uint8_t)k;
+                cell->iterations = (uint8_t)(iterations[l] > 255 ? 255 : iterations[l]);
+            }
+        }
+    }
+}
+
+// Write the raster; returns 0 on success
+int write_raster(const char *path, const RootSet *roots, const BasinCell cells[], size_t width, size_t height)
+{
+    if (width > INT32_MAX || height > INT32_MAX)
+    {
+        printf("Error: %zu x %zu is too large for the raster header.\n", width, height);
+        return -1;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        printf("Error: cannot open %s for writing.\n", path);
+        return -1;
+    }
+
+    int32_t header[3] = {(int32_t)width, (int32_t)height, roots->count};
+    fwrite("NRBASIN1", 1, 8, file);
+    fwrite(header, sizeof(header), 1, file);
+    for (int k = 0; k < roots->count; k++)
+    {
+        fwrite(&roots->re[k], sizeof(double), 1, file);
+        fwrite(&roots->im[k], sizeof(double), 1, file);
+    }
+    fwrite(cells, sizeof(BasinCell), width * height, file);
+    return fclose(file);
+}
+
+// Print how many starts reached each root
+static void print_summary(const char *title, const RootSet *roots, const BasinCell cells[], size_t n, double elapsed)
+{
+    size_t counts[MAX_ROOTS + 1] = {0};
+    double total_iterations = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        counts[cells[i].root == NO_ROOT ? MAX_ROOTS : cells[i].root]++;
+        total_iterations += cells[i].iterations;
+    }
+
+    printf("\n%s\n", title);
+    printf("----------------------------------------------------------\n");
+    for (int k = 0; k < roots->count; k++)
+        printf("Root %d: %10.6f %+10.6fi  basin %6.2f%%\n", k, roots->re[k], roots->im[k], 100.0 * counts[k] / n);
+    printf("No convergence: %6.2f%%\n", 100.0 * counts[MAX_ROOTS] / n);
+    printf("Average iterations: %.2f\n", total_iterations / n);
+    printf("Time: %.3f s (%.1f million starts/s)\n", elapsed, n / elapsed / 1e6);
+    printf("----------------------------------------------------------\n");
+}
+
+// Wall clock time in seconds
+static double wall_time(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Driver method
+int main(int argc, char const *argv[])
+{
+    int resolution = argc > 1 ? atoi(argv[1]) : 2000;
+    const char *prefix = argc > 2 ? argv[2] : "basins";
+    const char *method[] = {"newton", "secant"};
+    char path[4096];
+    RootSet roots;
+
+    if (resolution < 2)
+    {
+        printf("Invalid resolution.\n");
+        return 1;
+    }
+
+    // 1-D basins of f(x) = x^3 - 2x + 2 (has a 2-cycle between 0 and 1)
+    size_t width = (size_t)resolution * resolution;
+    BasinCell *line = malloc(width * sizeof(BasinCell));
+    if (!line)
+    {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    for (int use_secant = 0; use_secant <= 1; use_secant++)
+    {
+        double start = wall_time();
+        basins_real(-3.0, 3.0, width, use_secant, &roots, line);
+        print_summary(use_secant ? "Secant basins of x^3 - 2x + 2 on [-3, 3]" : "Newton basins of x^3 - 2x + 2 on [-3, 3]",
+                      &roots, line, width, wall_time() - start);
+
+        snprintf(path, sizeof(path), "%s-%s.bin", prefix, method[use_secant]);
+        if (write_raster(path, &roots, line, width, 1) == 0)
+            printf("Raster written to %s (%zu x 1)\n", path, width);
+    }
+    free(line);
+
+    // 2-D basins of p(z) = z^3 - 1
+    double coef[] = {-1.0, 0.0, 0.0, 1.0};
+    BasinCell *grid = malloc((size_t)resolution * resolution * sizeof(BasinCell));
+    if (!grid)
+    {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    double start = wall_time();
+    basins_complex(coef, 3, -2.0, 2.0, -2.0, 2.0, resolution, resolution, &roots, grid);
+    print_summary("Newton basins of z^3 - 1 on [-2, 2] x [-2, 2]", &roots, grid, (size_t)resolution * resolution,
+                  wall_time() - start);
+
+    snprintf(path, sizeof(path), "%s-complex.bin", prefix);
+    if (write_raster(path, &roots, grid, resolution, resolution) == 0)
+        printf("Raster written to %s (%d x %d)\n", path, resolution, resolution);
+    free(grid);
+
+    return 0;
+}
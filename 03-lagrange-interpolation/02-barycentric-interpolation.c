@@ -0,0 +1,227 @@
+// Barycentric Lagrange interpolation
+// The weights are computed once in O(n^2); every evaluation after that costs O(n).
+// Compile: gcc -O3 -march=native -fopenmp 02-barycentric-interpolation.c -o barycentric -lm
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <limits.h>
+# include <math.h>
+# include <time.h>
+
+// Interpolant through n points with precomputed barycentric weights
+typedef struct {
+    int n;
+    double *x; // Nodes
+    double *y; // Values at the nodes
+    double *w; // Barycentric weights
+} Barycentric;
+
+// Release the interpolant's arrays
+void barycentric_free(Barycentric *p) {
+    free(p->x);
+    free(p->y);
+    free(p->w);
+    memset(p, 0, sizeof(*p));
+}
+
+// Compute the weights for the points (x[i], y[i]); returns 0 on success, -1 on error
+int barycentric_init(Barycentric *p, const double x[], const double y[], int n) {
+    memset(p, 0, sizeof(*p));
+    if (n <= 0) {
+        printf("No data points provided.\n");
+        return -1;
+    }
+
+    p->n = n;
+    p->x = malloc(n * sizeof(double));
+    p->y = malloc(n * sizeof(double));
+    p->w = malloc(n * sizeof(double));
+    if (!p->x || !p->y || !p->w) {
+        printf("Memory allocation failed.\n");
+        barycentric_free(p);
+        return -1;
+    }
+    memcpy(p->x, x, n * sizeof(double));
+    memcpy(p->y, y, n * sizeof(double));
+
+    // w[i] = 1 / prod_{j != i} (x[i] - x[j]). For large n the products overflow or underflow
+    // (for equispaced nodes they span about 2^n), so each is kept as a mantissa in [0.5, 1)
+    // and a binary exponent, stored for now in w[i] and exponent[i]
+    int *exponent = malloc(n * sizeof(int));
+    if (!exponent) {
+        printf("Memory allocation failed.\n");
+        barycentric_free(p);
+        return -1;
+    }
+    int largest = INT_MIN;
+    for (int i = 0; i < n; i++) {
+        double mantissa = 1.0;
+        int e = 0;
+        for (int j = 0; j < n; j++) {
+            if (j == i) {
+                continue;
+            }
+            if (x[i] == x[j]) {
+                printf("Error: repeated node x = %g.\n", x[i]);
+                free(exponent);
+                barycentric_free(p);
+                return -1;
+            }
+            int factor_exponent;
+            mantissa = frexp(mantissa * (x[i] - x[j]), &factor_exponent);
+            e += factor_exponent;
+        }
+        p->w[i] = mantissa;
+        exponent[i] = e;
+        if (-e > largest) {
+            largest = -e;
+        }
+    }
+
+    // The second barycentric formula does not change when all weights are scaled by the same
+    // factor, so they are scaled to make the largest about 1 (the smallest may underflow to 0)
+    for (int i = 0; i < n; i++) {
+        p->w[i] = ldexp(1.0 / p->w[i], -exponent[i] - largest);
+    }
+    free(exponent);
+
+    return 0;
+}
+
+// Evaluate the interpolant at xp using the second (true) barycentric formula
+double barycentric_eval(const Barycentric *p, double xp) {
+    double num = 0.0, den = 0.0;
+
+    # ifdef _OPENMP
+    # pragma omp simd reduction(+ : num, den)
+    # endif
+    for (int j = 0; j < p->n; j++) {
+        double t = p->w[j] / (xp - p->x[j]);
+        num += t * p->y[j];
+        den += t;
+    }
+
+    double yp = num / den;
+    if (isfinite(yp)) {
+        return yp;
+    }
+
+    // xp coincides with a node (division by zero above)
+    for (int j = 0; j < p->n; j++) {
+        if (xp == p->x[j]) {
+            return p->y[j];
+        }
+    }
+    return yp;
+}
+
+// Evaluate the interpolant at m query points, split across threads
+void barycentric_eval_batch(const Barycentric *p, const double xp[], double yp[], long m) {
+    # ifdef _OPENMP
+    # pragma omp parallel for schedule(static)
+    # endif
+    for (long i = 0; i < m; i++) {
+        yp[i] = barycentric_eval(p, xp[i]);
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Main function
+int main(int argc, char const *argv[])
+{
+    Barycentric p;
+    double xp;
+    int n;
+
+    printf("Enter the number of data points: ");
+    if (scanf("%d", &n) != 1 || n <= 0) {
+        printf("Invalid number of data points.\n");
+        return 1;
+    }
+
+    double *x = malloc(n * sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    if (!x || !y) {
+        printf("Memory allocation failed.\n");
+        free(x);
+        free(y);
+        return 1;
+    }
+
+    printf("Enter the data points (x y):\n");
+    for (int i = 0; i < n; i++) {
+        scanf("%lf %lf", &x[i], &y[i]);
+    }
+
+    printf("Enter the value of x for interpolation: ");
+    scanf("%lf", &xp);
+
+    if (barycentric_init(&p, x, y, n) != 0) {
+        free(x);
+        free(y);
+        return 1;
+    }
+    printf("\nThe interpolated value at x = %.2f is y = %.6f\n", xp, barycentric_eval(&p, xp));
+    barycentric_free(&p);
+    free(x);
+    free(y);
+
+    // Batch evaluation: interpolate sin(x) on [-1, 1] through Chebyshev points
+    int nodes = 64;
+    long queries = 10000000;
+    double *cx = malloc(nodes * sizeof(double));
+    double *cy = malloc(nodes * sizeof(double));
+    double *qx = malloc(queries * sizeof(double));
+    double *qy = malloc(queries * sizeof(double));
+    if (!cx || !cy || !qx || !qy) {
+        printf("Memory allocation failed.\n");
+        free(cx);
+        free(cy);
+        free(qx);
+        free(qy);
+        return 1;
+    }
+    for (int i = 0; i < nodes; i++) {
+        cx[i] = cos(M_PI * (i + 0.5) / nodes);
+        cy[i] = sin(cx[i]);
+    }
+    for (long i = 0; i < queries; i++) {
+        qx[i] = -1.0 + 2.0 * i / (queries - 1);
+    }
+
+    double start = wall_time();
+    if (barycentric_init(&p, cx, cy, nodes) != 0) {
+        free(cx);
+        free(cy);
+        free(qx);
+        free(qy);
+        return 1;
+    }
+    barycentric_eval_batch(&p, qx, qy, queries);
+    double elapsed = wall_time() - start;
+
+    double max_error = 0.0;
+    for (long i = 0; i < queries; i++) {
+        double error = fabs(qy[i] - sin(qx[i]));
+        if (error > max_error) {
+            max_error = error;
+        }
+    }
+    printf("\nBatch evaluation of sin(x) through %d Chebyshev points:\n", nodes);
+    printf("Queries: %ld, time: %.4f s (%.2f million points/s), max error: %.2e\n",
+           queries, elapsed, queries / elapsed / 1e6, max_error);
+
+    barycentric_free(&p);
+    free(cx);
+    free(cy);
+    free(qx);
+    free(qy);
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/expression.h"
 
 # define N 1000 // Number of subintervals for numerical integration
 
@@ -58,22 +59,44 @@ double example_function(double x) {
     return 1 / x; // Example: f(x) = 1/x, note this function is not defined at x = 0
 }
 
+// Expression given on the command line, e.g. "x*exp(x)-cos(x)"
+Expression expression;
+
+// Integrand compiled from the command line
+double expression_function(double x) {
+    return expr_eval(&expression, x, 0.0);
+}
+
 // Main function
-int main() {
+int main(int argc, char const *argv[]) {
     double a = 1.0; // Lower limit of integration
     double b = 2.0; // Upper limit of integration
     int n = N;    // Number of subintervals
+    double (*f)(double) = example_function;
+
+    // Usage: ./integration ["expression" [a b]]
+    if (argc > 1) {
+        if (expr_compile(&expression, argv[1]) != 0) {
+            return 1;
+        }
+        f = expression_function;
+        printf("Function: f(x) = %s\n", argv[1]);
+    }
+    if (argc > 3) {
+        a = atof(argv[2]);
+        b = atof(argv[3]);
+    }
 
     // Calculate the integral using the all rules
-    double trapezoidal_result = trapezoidal_rule(example_function, a, b, n);
-    double simpson_13_result = simpsons_13_rule(example_function, a, b, n);
-    double simpson_38_result = simpsons_38_rule(example_function, a, b, n);
+    double trapezoidal_result = trapezoidal_rule(f, a, b, n);
+    double simpson_13_result = simpsons_13_rule(f, a, b, n);
+    double simpson_38_result = simpsons_38_rule(f, a, b, n);
     
     // Print the result
     printf("The integral of f(x) from %.2f to %.2f is approximately:\n", a, b);
     printf("1. Trapezoidal Rule: %.6f\n", trapezoidal_result);
-    printf("2. Simpson 1/3 Rule: %.6f\n", trapezoidal_result);
-    printf("3. Simpson 3/8 Rule: %.6f\n", trapezoidal_result);
+    printf("2. Simpson 1/3 Rule: %.6f\n", simpson_13_result);
+    printf("3. Simpson 3/8 Rule: %.6f\n", simpson_38_result);
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// Batch solver for a*x^2 + b*x + c = 0 over structure-of-arrays coefficients
+// Compile: gcc -O3 -march=native -fopenmp 02-quadratic-solver.c -o quadratic -lm
+// Add -DQUAD_USE_FMA for the FMA-compensated discriminant.
+
+# define N 10000000 // Number of quadratics in the benchmark
+
+// Kind of roots found for each quadratic
+typedef enum {
+    QUAD_REAL = 0,   // Two distinct real roots, r1 <= r2
+    QUAD_DOUBLE,     // One repeated real root, r1 == r2
+    QUAD_COMPLEX,    // Complex pair r1 +/- i*r2
+    QUAD_LINEAR,     // a == 0: single root r1 == r2 == -c/b
+    QUAD_DEGENERATE, // a == b == 0, c != 0: no root, r1 = r2 = NaN
+    QUAD_IDENTITY,   // a == b == c == 0: every x is a root, r1 = r2 = NaN
+    QUAD_KINDS       // Number of kinds
+} QuadraticKind;
+
+// Discriminant b^2 - 4ac
+static inline double discriminant(double a, double b, double c) {
+#ifdef QUAD_USE_FMA
+    // Kahan: recover the rounding errors of b*b and 4*a*c with FMA
+    double p = b * b;
+    double q = 4.0 * a * c;
+    double dp = fma(b, b, -p);
+    double dq = fma(4.0 * a, c, -q);
+    return (p - q) + (dp - dq);
+#else
+    return b * b - 4.0 * a * c;
+#endif
+}
+
+// Solve n quadratics; kind[i] tells how to read r1[i] and r2[i]
+void solve_quadratics(const double *restrict a, const double *restrict b, const double *restrict c,
+                      double *restrict r1, double *restrict r2, unsigned char *restrict kind, long n) {
+    # ifdef _OPENMP
+    # pragma omp parallel for simd schedule(static)
+    # endif
+    for (long i = 0; i < n; i++) {
+        double ai = a[i], bi = b[i], ci = c[i];
+        double d = discriminant(ai, bi, ci);
+        double s = sqrt(fabs(d));
+
+        // Cancellation-free form: q = -(b + sign(b) sqrt(d)) / 2, x1 = q / a, x2 = c / q
+        double q = -0.5 * (bi + copysign(s, bi));
+        double x1 = q / ai;
+        double x2 = q != 0.0 ? ci / q : 0.0;
+        double lo = fmin(x1, x2), hi = fmax(x1, x2);
+
+        // Complex pair: real part -b / 2a, imaginary part sqrt(-d) / 2|a|
+        double re = -bi / (2.0 * ai);
+        double im = s / (2.0 * fabs(ai));
+
+        // Linear equation
+        double lin = -ci / bi;
+
+        int linear = ai == 0.0;
+        int degenerate = linear && bi == 0.0;
+        int identity = degenerate && ci == 0.0;
+        int complex_pair = !linear && d < 0.0;
+        int repeated = !linear && d == 0.0;
+
+        r1[i] = degenerate ? NAN : linear ? lin : complex_pair ? re : repeated ? re : lo;
+        r2[i] = degenerate ? NAN : linear ? lin : complex_pair ? im : repeated ? re : hi;
+        kind[i] = identity ? QUAD_IDENTITY : degenerate ? QUAD_DEGENERATE : linear ? QUAD_LINEAR : complex_pair ? QUAD_COMPLEX
+                : repeated ? QUAD_DOUBLE : QUAD_REAL;
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Main function
+int main() {
+    const char *kinds[] = {"two real roots", "double root", "complex pair", "linear", "no root", "every x"};
+
+    // A few special cases
+    double ea[] = {1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    double eb[] = {-3.0, 2.0, 2.0, 2.0, 0.0, 0.0, 1e8};
+    double ec[] = {2.0, 1.0, 5.0, -4.0, 1.0, 0.0, 1.0};
+    double er1[7], er2[7];
+    unsigned char ek[7];
+    solve_quadratics(ea, eb, ec, er1, er2, ek, 7);
+
+    printf("Examples:\n");
+    for (int i = 0; i < 7; i++) {
+        printf("%gx^2 + %gx + %g = 0: %-14s r1 = %.10g, r2 = %.10g\n", ea[i], eb[i], ec[i], kinds[ek[i]], er1[i], er2[i]);
+    }
+
+    // The naive formula loses the small root of x^2 + 1e8 x + 1 to cancellation
+    double naive = (-eb[6] + sqrt(eb[6] * eb[6] - 4 * ea[6] * ec[6])) / (2 * ea[6]);
+    printf("Small root of x^2 + 1e8x + 1: stable %.10e, naive %.10e (exact -1.0000000000e-08)\n\n", er2[6], naive);
+
+    // Throughput benchmark
+    long n = N;
+    double *a = malloc(n * sizeof(double));
+    double *b = malloc(n * sizeof(double));
+    double *c = malloc(n * sizeof(double));
+    double *r1 = malloc(n * sizeof(double));
+    double *r2 = malloc(n * sizeof(double));
+    unsigned char *kind = malloc(n);
+    if (!a || !b || !c || !r1 || !r2 || !kind) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+
+    srand(1);
+    for (long i = 0; i < n; i++) {
+        a[i] = (i % 1000 == 0) ? 0.0 : 2.0 * rand() / RAND_MAX - 1.0;
+        b[i] = 2.0 * rand() / RAND_MAX - 1.0;
+        c[i] = 2.0 * rand() / RAND_MAX - 1.0;
+    }
+
+    solve_quadratics(a, b, c, r1, r2, kind, n); // Warm up
+    int repeats = 5;
+    double start = wall_time();
+    for (int r = 0; r < repeats; r++) {
+        solve_quadratics(a, b, c, r1, r2, kind, n);
+    }
+    double elapsed = (wall_time() - start) / repeats;
+
+    long counts[QUAD_KINDS] = {0};
+    double max_residual = 0.0;
+    for (long i = 0; i < n; i++) {
+        counts[kind[i]]++;
+        if (kind[i] == QUAD_REAL) {
+            double x = r2[i];
+            double residual = fabs((a[i] * x + b[i]) * x + c[i]) / (fabs(a[i] * x * x) + fabs(b[i] * x) + fabs(c[i]));
+            if (residual > max_residual) {
+                max_residual = residual;
+            }
+        }
+    }
+
+    printf("Benchmark: %ld quadratics\n", n);
+    for (int k = 0; k < QUAD_KINDS; k++) {
+        printf("  %-14s %ld\n", kinds[k], counts[k]);
+    }
+    printf("Time per batch: %.4f s, throughput: %.1f million quadratics/s (%.1f million roots/s)\n",
+           elapsed, n / elapsed / 1e6, 2.0 * n / elapsed / 1e6);
+    printf("Max relative residual (real roots): %.2e\n", max_residual);
+
+    free(a);
+    free(b);
+    free(c);
+    free(r1);
+    free(r2);
+    free(kind);
+
+    return 0;
+}
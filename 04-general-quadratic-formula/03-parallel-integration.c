@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../common/integration.h"
+
+// Serial vs parallel compensated composite rules for large n
+// Compile: gcc -O3 -march=native -fopenmp 03-parallel-integration.c -o parallel-integration -lm
+// Usage:   ./parallel-integration [n]
+
+# define N 100000000 // Default number of subintervals
+
+// Function to calculate the integral of a function using the trapezoidal rule (as in 01-numerical-integration.c)
+double trapezoidal_rule(double (*f)(double), double a, double b, long n) {
+    double h = (b - a) / n;
+    double sum = 0.5 * (f(a) + f(b));
+
+    for (long i = 1; i < n; i++) {
+        sum += f(a + i * h);
+    }
+
+    return sum * h;
+}
+
+// Function to calculate the integral of a function using Simpson's 1/3 rule (as in 01-numerical-integration.c)
+double simpsons_13_rule(double (*f)(double), double a, double b, long n) {
+    if (n % 2 != 0) {
+        n++;
+    }
+    double h = (b - a) / n;
+    double sum = f(a) + f(b);
+
+    for (long i = 1; i < n; i++) {
+        if (i % 2 == 0) {
+            sum += 2 * f(a + i * h);
+        } else {
+            sum += 4 * f(a + i * h);
+        }
+    }
+
+    return sum * h / 3;
+}
+
+// Function to calculate the integral of a function using Simpson's 3/8 rule (as in 01-numerical-integration.c)
+double simpsons_38_rule(double (*f)(double), double a, double b, long n) {
+    if (n % 3 != 0) {
+        n += 3 - (n % 3);
+    }
+    double h = (b - a) / n;
+    double sum = f(a) + f(b);
+
+    for (long i = 1; i < n; i++) {
+        if (i % 3 == 0) {
+            sum += 2 * f(a + i * h);
+        } else {
+            sum += 3 * f(a + i * h);
+        }
+    }
+
+    return sum * h * 3 / 8;
+}
+
+// Example function to integrate
+double example_function(double x) {
+    return 1 / x; // Example: f(x) = 1/x, exact integral over [1, 2] is ln 2
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Main function
+int main(int argc, char const *argv[]) {
+    double a = 1.0, b = 2.0;
+    long n = argc > 1 ? atol(argv[1]) : N;
+    double exact = log(2.0);
+
+    if (n <= 0) {
+        printf("Invalid number of subintervals.\n");
+        return 1;
+    }
+
+    const char *names[] = {"Trapezoidal Rule", "Simpson 1/3 Rule", "Simpson 3/8 Rule"};
+    double (*serial[])(double (*)(double), double, double, long) = {trapezoidal_rule, simpsons_13_rule, simpsons_38_rule};
+    double (*parallel[])(double (*)(double), double, double, long) = {trapezoidal_parallel, simpsons_13_parallel,
+                                                                     simpsons_38_parallel};
+
+    printf("Integral of 1/x from %.2f to %.2f with n = %ld (exact %.16f)\n", a, b, n, exact);
+    printf("----------------------------------------------------------------------------\n");
+    printf("%-18s %-9s %22s %10s %10s\n", "Rule", "Version", "Result", "Error", "Time (s)");
+    printf("----------------------------------------------------------------------------\n");
+    for (int r = 0; r < 3; r++) {
+        double start = wall_time();
+        double result = serial[r](example_function, a, b, n);
+        double elapsed = wall_time() - start;
+        printf("%-18s %-9s %22.16f %10.2e %10.3f\n", names[r], "serial", result, fabs(result - exact), elapsed);
+
+        start = wall_time();
+        result = parallel[r](example_function, a, b, n);
+        elapsed = wall_time() - start;
+        printf("%-18s %-9s %22.16f %10.2e %10.3f\n", names[r], "parallel", result, fabs(result - exact), elapsed);
+    }
+    printf("----------------------------------------------------------------------------\n");
+
+    return 0;
+}
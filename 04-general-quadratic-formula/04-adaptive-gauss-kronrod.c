@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <math.h>
+#include "../common/gauss_kronrod.h"
+
+// Adaptive Gauss-Kronrod vs uniform Simpson 1/3
+// For each test integrand, Simpson's n is doubled until it reaches the same accuracy.
+
+# define TOLERANCE 1e-10
+# define MAX_INTERVALS 1000
+# define MAX_SIMPSON_N (1L << 24)
+
+long evaluations = 0; // Calls to the current integrand
+double (*integrand)(double);
+
+// Counts evaluations of the current integrand
+double counted(double x) {
+    evaluations++;
+    return integrand(x);
+}
+
+// Function to calculate the integral of a function using Simpson's 1/3 rule (as in 01-numerical-integration.c)
+double simpsons_13_rule(double (*f)(double), double a, double b, long n) {
+    if (n % 2 != 0) {
+        n++; // n must be even for Simpson's rule
+    }
+    double h = (b - a) / n;
+    double sum = f(a) + f(b);
+
+    for (long i = 1; i < n; i++) {
+        sum += (i % 2 == 0 ? 2 : 4) * f(a + i * h);
+    }
+
+    return sum * h / 3;
+}
+
+// Test integrands
+double reciprocal(double x) { return 1 / x; }
+double square_root(double x) { return sqrt(x); }
+double peak(double x) { return 1 / (1e-4 + (x - 0.3) * (x - 0.3)); }
+double oscillating(double x) { return cos(50 * x) * exp(-x); }
+
+// Main function
+int main() {
+    struct {
+        const char *name;
+        double (*f)(double);
+        double a, b, exact;
+    } tests[] = {
+        {"1/x on [1, 2]", reciprocal, 1.0, 2.0, log(2.0)},
+        {"sqrt(x) on [0, 1]", square_root, 0.0, 1.0, 2.0 / 3.0},
+        {"1/(1e-4 + (x-0.3)^2) on [0, 1]", peak, 0.0, 1.0, 100 * (atan(70.0) + atan(30.0))},
+        {"cos(50x) e^-x on [0, 2]", oscillating, 0.0, 2.0,
+         (1 + exp(-2.0) * (50 * sin(100.0) - cos(100.0))) / 2501},
+    };
+    int count = sizeof(tests) / sizeof(tests[0]);
+
+    printf("Tolerance: %.0e (absolute and relative)\n", TOLERANCE);
+    for (int t = 0; t < count; t++) {
+        QuadratureResult result;
+        integrand = tests[t].f;
+
+        evaluations = 0;
+        int status = gauss_kronrod(counted, tests[t].a, tests[t].b, TOLERANCE, TOLERANCE, MAX_INTERVALS, &result);
+        if (status < 0) {
+            printf("Memory allocation failed.\n");
+            return 1;
+        }
+
+        // Smallest power-of-two n for which Simpson 1/3 is as accurate
+        long n = 2, simpson_evals = 0;
+        double simpson = 0.0;
+        for (; n <= MAX_SIMPSON_N; n *= 2) {
+            evaluations = 0;
+            simpson = simpsons_13_rule(counted, tests[t].a, tests[t].b, n);
+            simpson_evals = evaluations;
+            if (fabs(simpson - tests[t].exact) <= fabs(result.value - tests[t].exact) || fabs(simpson - tests[t].exact) <= TOLERANCE) {
+                break;
+            }
+        }
+
+        printf("\n%s (exact %.15f)\n", tests[t].name, tests[t].exact);
+        printf("---------------------------------------------------------------------\n");
+        printf("Gauss-Kronrod: %.15f  error %.2e (estimate %.2e)\n", result.value, fabs(result.value - tests[t].exact), result.error);
+        printf("               %ld evaluations, %d subintervals%s\n", result.evaluations, result.intervals,
+               status == 1 ? ", subinterval limit reached" : "");
+        printf("Simpson 1/3:   %.15f  error %.2e\n", simpson, fabs(simpson - tests[t].exact));
+        printf("               %ld evaluations (n = %ld)%s\n", simpson_evals, n > MAX_SIMPSON_N ? n / 2 : n,
+               n > MAX_SIMPSON_N ? ", did not reach the same accuracy" : "");
+        printf("---------------------------------------------------------------------\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "../common/gauss_legendre.h"
+
+// Gauss-Legendre and Gauss-Lobatto quadrature on the examples of this folder and 06-rombergs-integration
+// Compile: gcc -O3 -march=native -fopenmp 05-gauss-legendre.c -o gauss -lm
+
+# define PANELS 1000000 // Panels in the composite timing run
+# define REPEATS 5 // Timing runs per method
+
+// Example functions to integrate
+double example_function(double x) {
+    return 1 / x; // f(x) = 1/x on [1, 2], exact ln 2
+}
+
+double romberg_example(double x) {
+    return sin(x); // f(x) = sin(x) on [0, pi], exact 2
+}
+
+// Batch version of example_function for the vectorized composite rule
+void example_batch(const double x[], double fx[], int n) {
+    for (int i = 0; i < n; i++) {
+        fx[i] = 1 / x[i];
+    }
+}
+
+// Degree 7 polynomial (the 4-point rule is exact for it), x^7 - 3x^4 + 2x on [1, 2], exact 16.275.
+// Unlike 1/x it needs no division, whose throughput limits both versions about equally
+double polynomial_function(double x) {
+    double x2 = x * x;
+    return ((x2 * x - 3.0) * x2 * x + 2.0) * x;
+}
+
+void polynomial_batch(const double x[], double fx[], int n) {
+    for (int i = 0; i < n; i++) {
+        double x2 = x[i] * x[i];
+        fx[i] = ((x2 * x[i] - 3.0) * x2 * x[i] + 2.0) * x[i];
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Time the scalar and batch composite rules on [1, 2], best of REPEATS runs each so the
+// first run's cold caches do not count against one side. f arrives as a pointer, as it does
+// for most callers, so the scalar rule pays one indirect call per abscissa and the batch
+// rule one per block
+static void time_composite(const GaussRule *rule, const char *name, double (*f)(double),
+                           gauss_batch_function batch_f, double exact) {
+    double scalar = 0.0, batch = 0.0, scalar_time = INFINITY, batch_time = INFINITY;
+    for (int r = 0; r < REPEATS; r++) {
+        double start = wall_time();
+        scalar = gauss_composite(rule, f, 1.0, 2.0, PANELS);
+        scalar_time = fmin(scalar_time, wall_time() - start);
+        start = wall_time();
+        batch = gauss_composite_batch(rule, batch_f, 1.0, 2.0, PANELS);
+        batch_time = fmin(batch_time, wall_time() - start);
+    }
+
+    printf("Composite 4-point Legendre, %d panels of %s, best of %d runs\n", PANELS, name, REPEATS);
+    printf("Scalar: %.16f (error %.2e) in %.4f s\n", scalar, fabs(scalar - exact), scalar_time);
+    printf("Batch:  %.16f (error %.2e) in %.4f s (%.1fx)\n", batch, fabs(batch - exact), batch_time,
+           scalar_time / batch_time);
+}
+
+// Main function
+int main() {
+    const char *kinds[] = {"Legendre", "Lobatto"};
+
+    // Tabulated rules against the ones Newton iteration produces at runtime
+    double max_difference = 0.0;
+    for (GaussKind kind = GAUSS_LEGENDRE; kind <= GAUSS_LOBATTO; kind++) {
+        for (int n = kind == GAUSS_LEGENDRE ? 2 : 3; n <= GAUSS_TABLE_ORDER; n++) {
+            const GaussRule *rule = gauss_rule(kind, n);
+            for (int k = 0; k < (n + 1) / 2; k++) {
+                double x, w;
+                gauss_newton_node(kind, n, k, &x, &w);
+                max_difference = fmax(max_difference, fabs(x - rule->x[n - 1 - k]));
+                max_difference = fmax(max_difference, fabs(w - rule->w[n - 1 - k]));
+            }
+        }
+    }
+    printf("Tables vs Newton iteration: max difference %.2e\n\n", max_difference);
+
+    // Accuracy per evaluation
+    printf("Single panel, n evaluations\n");
+    printf("-----------------------------------------------------------------\n");
+    printf("%-4s %-10s %-16s %-16s\n", "n", "Rule", "Error 1/x [1,2]", "Error sin [0,pi]");
+    printf("-----------------------------------------------------------------\n");
+    for (int n = 3; n <= 10; n++) {
+        for (GaussKind kind = GAUSS_LEGENDRE; kind <= GAUSS_LOBATTO; kind++) {
+            const GaussRule *rule = gauss_rule(kind, n);
+            if (!rule) {
+                printf("Memory allocation failed.\n");
+                return 1;
+            }
+            double e1 = fabs(gauss_integrate(rule, example_function, 1.0, 2.0) - log(2.0));
+            double e2 = fabs(gauss_integrate(rule, romberg_example, 0.0, M_PI) - 2.0);
+            printf("%-4d %-10s %-16.2e %-16.2e\n", n, kinds[kind], e1, e2);
+        }
+    }
+    printf("-----------------------------------------------------------------\n\n");
+
+    // Large orders are computed once and cached
+    double start = wall_time();
+    const GaussRule *large = gauss_rule(GAUSS_LEGENDRE, 1000);
+    double build = wall_time() - start;
+    start = wall_time();
+    gauss_rule(GAUSS_LEGENDRE, 1000);
+    double cached = wall_time() - start;
+    if (!large) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    double weight_sum = 0.0;
+    for (int i = 0; i < large->n; i++) {
+        weight_sum += large->w[i];
+    }
+    printf("1000-point Legendre rule: built in %.4f s, cached lookup %.2e s, sum of weights - 2 = %.2e\n\n",
+           build, cached, weight_sum - 2.0);
+
+    // Composite panels: scalar integrand against batch integrand
+    const GaussRule *rule = gauss_rule(GAUSS_LEGENDRE, 4);
+    time_composite(rule, "1/x on [1, 2]", example_function, example_batch, log(2.0));
+    time_composite(rule, "x^7 - 3x^4 + 2x on [1, 2]", polynomial_function, polynomial_batch, 16.275);
+
+    gauss_free_cache();
+
+    return 0;
+}
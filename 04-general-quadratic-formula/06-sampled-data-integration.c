@@ -0,0 +1,259 @@
+#define _DEFAULT_SOURCE // madvise
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../common/integration.h"
+#include "../common/csv_pairs.h"
+
+// Streaming trapezoidal and Simpson integration of sampled (x, y) data
+// The samples are read once, in chunks, from
+//   - a binary file of interleaved doubles x0 y0 x1 y1 ... (memory-mapped), or
+//   - a CSV file with one "x,y" pair per line (read in blocks with csv_pairs.h, the next
+//     block is read by a second thread while the current one is parsed).
+// Spacing may be non-uniform; x must be increasing.
+// Compile: gcc -O3 -march=native -fopenmp 06-sampled-data-integration.c -o sampled -lm
+// Usage:   ./sampled [file.bin | file.csv]   (without a file, test data is generated)
+
+# define CHUNK_POINTS (1 << 20)   // Points integrated per chunk of the mapped file
+# define TEST_POINTS 2000000      // Samples in the generated test files
+
+// Running state carried from one chunk to the next
+typedef struct {
+    KahanSum trapezoid;
+    KahanSum simpson;
+    long points;
+    double last_x, last_y;       // Last point seen (trapezoid)
+    double anchor_x, anchor_y;   // Start of the next Simpson pair (even global index)
+    double pending_x, pending_y; // Odd point after the anchor, if pending
+    int pending;
+} SampledIntegral;
+
+// Simpson's rule over [x0, x2] with a midpoint x1 anywhere inside (non-uniform spacing)
+static inline double simpson_pair(double x0, double y0, double x1, double y1, double x2, double y2) {
+    double h0 = x1 - x0, h1 = x2 - x1, h = h0 + h1;
+    return h / 6 * ((2 - h1 / h0) * y0 + h * h / (h0 * h1) * y1 + (2 - h0 / h1) * y2);
+}
+
+// Add m interleaved points xy[2i], xy[2i + 1] to the running integrals
+void sampled_add(SampledIntegral *s, const double *xy, long m) {
+    long j = 0; // First point of this chunk not yet used by Simpson
+    double trapezoid = 0.0, simpson = 0.0;
+
+    if (m <= 0) {
+        return;
+    }
+
+    if (s->points == 0) {
+        // First point ever: it becomes the anchor
+        s->anchor_x = xy[0];
+        s->anchor_y = xy[1];
+        j = 1;
+    } else {
+        // Interval joining the previous chunk
+        trapezoid = 0.5 * (xy[0] - s->last_x) * (xy[1] + s->last_y);
+    }
+
+    # ifdef _OPENMP
+    # pragma omp simd reduction(+ : trapezoid)
+    # endif
+    for (long i = 1; i < m; i++) {
+        trapezoid += 0.5 * (xy[2 * i] - xy[2 * i - 2]) * (xy[2 * i + 1] + xy[2 * i - 1]);
+    }
+
+    // Simpson: close the pair left open by the previous chunk
+    if (s->pending) {
+        simpson += simpson_pair(s->anchor_x, s->anchor_y, s->pending_x, s->pending_y, xy[0], xy[1]);
+        s->pending = 0;
+        j = 1;
+    } else if (j == 0 && m >= 2) {
+        simpson += simpson_pair(s->anchor_x, s->anchor_y, xy[0], xy[1], xy[2], xy[3]);
+        j = 2;
+    }
+
+    // The anchor is now xy[j - 1]; the remaining pairs lie inside the chunk
+    if (j >= 1) {
+        long pairs = (m - j) / 2;
+        const double *p = xy + 2 * (j - 1);
+
+        # ifdef _OPENMP
+        # pragma omp simd reduction(+ : simpson)
+        # endif
+        for (long k = 0; k < pairs; k++) {
+            simpson += simpson_pair(p[4 * k], p[4 * k + 1], p[4 * k + 2], p[4 * k + 3], p[4 * k + 4], p[4 * k + 5]);
+        }
+        j += 2 * pairs;
+        s->anchor_x = xy[2 * j - 2];
+        s->anchor_y = xy[2 * j - 1];
+    }
+    if (j < m) {
+        // One point after the anchor is left over
+        s->pending = 1;
+        s->pending_x = xy[2 * j];
+        s->pending_y = xy[2 * j + 1];
+    }
+
+    kahan_add(&s->trapezoid, trapezoid);
+    kahan_add(&s->simpson, simpson);
+    s->points += m;
+    s->last_x = xy[2 * m - 2];
+    s->last_y = xy[2 * m - 1];
+}
+
+// Trapezoidal result
+double sampled_trapezoid(const SampledIntegral *s) {
+    return kahan_result(&s->trapezoid);
+}
+
+// Simpson result; an odd number of intervals ends with one trapezoid
+double sampled_simpson(const SampledIntegral *s) {
+    double tail = s->pending ? 0.5 * (s->pending_x - s->anchor_x) * (s->pending_y + s->anchor_y) : 0.0;
+    return kahan_result(&s->simpson) + tail;
+}
+
+// Integrate a memory-mapped binary file of interleaved doubles; returns 0 or -1 on error
+int integrate_binary(const char *path, SampledIntegral *s) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("Error: cannot open %s.\n", path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    if (st.st_size % (2 * sizeof(double)) != 0) {
+        printf("Error: %s is not a whole number of (x, y) pairs.\n", path);
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    const double *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        printf("Error: cannot map %s.\n", path);
+        return -1;
+    }
+    madvise((void *)data, st.st_size, MADV_SEQUENTIAL);
+
+    long points = st.st_size / (2 * sizeof(double));
+    long page = sysconf(_SC_PAGESIZE);
+    for (long start = 0; start < points; start += CHUNK_POINTS) {
+        long m = points - start < CHUNK_POINTS ? points - start : CHUNK_POINTS;
+
+        // Ask the kernel to read the next chunk while this one is integrated
+        long next = start + CHUNK_POINTS;
+        if (next < points) {
+            long offset = next * 2 * sizeof(double) / page * page;
+            long length = CHUNK_POINTS * 2 * sizeof(double);
+            if (offset + length > st.st_size) {
+                length = st.st_size - offset;
+            }
+            madvise((char *)data + offset, length, MADV_WILLNEED);
+        }
+
+        sampled_add(s, data + 2 * start, m);
+    }
+
+    munmap((void *)data, st.st_size);
+    return 0;
+}
+
+// Consumer for csv_read_pairs()
+static void integrate_pairs(void *s, const double *xy, long m) {
+    sampled_add(s, xy, m);
+}
+
+// Integrate a CSV file read in blocks; returns 0 or -1 on error
+int integrate_csv(const char *path, SampledIntegral *s) {
+    return csv_read_pairs(path, integrate_pairs, s);
+}
+
+// Write TEST_POINTS samples of sin(x) on [0, pi] with spacing that grows along x
+int write_test_files(const char *binary, const char *csv) {
+    FILE *fb = fopen(binary, "wb"), *fc = fopen(csv, "w");
+    if (!fb || !fc) {
+        printf("Error: cannot create the test files.\n");
+        if (fb) {
+            fclose(fb);
+        }
+        if (fc) {
+            fclose(fc);
+        }
+        return -1;
+    }
+
+    fprintf(fc, "x,y\n");
+    for (long i = 0; i < TEST_POINTS; i++) {
+        double t = (double)i / (TEST_POINTS - 1);
+        double xy[2] = {M_PI * t * t, sin(M_PI * t * t)};
+        fwrite(xy, sizeof(double), 2, fb);
+        fprintf(fc, "%.17g,%.17g\n", xy[0], xy[1]);
+    }
+
+    fclose(fb);
+    return fclose(fc);
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Integrate one file and print the results
+int report(const char *path, double exact) {
+    SampledIntegral s = {0};
+    size_t n = strlen(path);
+    int csv = n >= 4 && strcmp(path + n - 4, ".csv") == 0;
+    struct stat st;
+
+    double start = wall_time();
+    if ((csv ? integrate_csv(path, &s) : integrate_binary(path, &s)) != 0) {
+        return -1;
+    }
+    double elapsed = wall_time() - start;
+    stat(path, &st);
+
+    printf("\n%s (%s, %ld points)\n", path, csv ? "CSV" : "binary", s.points);
+    printf("--------------------------------------------------------------\n");
+    if (isnan(exact)) {
+        printf("Trapezoidal Rule: %.15f\n", sampled_trapezoid(&s));
+        printf("Simpson 1/3 Rule: %.15f\n", sampled_simpson(&s));
+    } else {
+        printf("Trapezoidal Rule: %.15f (error %.2e)\n", sampled_trapezoid(&s), fabs(sampled_trapezoid(&s) - exact));
+        printf("Simpson 1/3 Rule: %.15f (error %.2e)\n", sampled_simpson(&s), fabs(sampled_simpson(&s) - exact));
+    }
+    printf("Time: %.3f s (%.1f MB/s)\n", elapsed, st.st_size / elapsed / 1e6);
+    printf("--------------------------------------------------------------\n");
+    return 0;
+}
+
+// Main function
+int main(int argc, char const *argv[]) {
+    if (argc > 1) {
+        return report(argv[1], NAN) != 0;
+    }
+
+    // No file given: generate samples of sin(x) on [0, pi], exact integral 2
+    const char *binary = "samples.bin", *csv = "samples.csv";
+    if (write_test_files(binary, csv) != 0) {
+        return 1;
+    }
+    int status = report(binary, 2.0) != 0 || report(csv, 2.0) != 0;
+    remove(binary);
+    remove(csv);
+
+    return status;
+}
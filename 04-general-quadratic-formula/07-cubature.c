@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "../common/gauss_legendre.h"
+
+// Multi-dimensional integration over a box [a_1, b_1] x ... x [a_d, b_d]
+//   - tensor product of Gauss-Legendre rules
+//   - Smolyak sparse grid (combination technique over the same 1-D rules)
+//   - Monte Carlo, Halton and Sobol quasi-Monte Carlo with running error estimates
+// Random numbers come from a counter-based generator: the value for (sample, dimension) is a
+// hash of the seed and the counter, so every thread can produce any part of the stream, and
+// block sums are added in a fixed order, so the sampling results do not depend on the
+// thread count.
+// Compile: gcc -O3 -march=native -fopenmp 07-cubature.c -o cubature -lm
+
+# define MAX_DIMENSIONS 20
+# define BLOCK 4096          // Samples per block (the unit of work and of summation)
+# define REPLICATES 8        // Randomized copies of a QMC rule for the error estimate
+# define MAX_SAMPLES (1L << 22)
+
+// Integrand of d variables
+typedef double (*multi_function)(const double x[], int d);
+
+// Result of a cubature
+typedef struct {
+    double value;
+    double error;     // Estimated (QMC, MC: one standard error) or NAN when unknown
+    long evaluations;
+} CubatureResult;
+
+typedef enum {
+    MONTE_CARLO = 0,
+    HALTON,
+    SOBOL
+} SamplingMethod;
+
+// ---------------------------------------------------------------------------
+// Counter-based random numbers
+// ---------------------------------------------------------------------------
+
+// SplitMix64 finalizer: a bijective hash of a 64-bit counter
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Random 64 bits for (seed, stream, counter)
+static inline uint64_t random_bits(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return mix64(mix64(seed ^ mix64(stream + 0x9E3779B97F4A7C15ULL)) + counter * 0x9E3779B97F4A7C15ULL);
+}
+
+// Uniform double in [0, 1)
+static inline double random_uniform(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return (random_bits(seed, stream, counter) >> 11) * 0x1.0p-53;
+}
+
+// ---------------------------------------------------------------------------
+// Low-discrepancy sequences
+// ---------------------------------------------------------------------------
+
+static const int primes[MAX_DIMENSIONS] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71};
+
+// Radical inverse of i in base b (Halton coordinate)
+static inline double radical_inverse(uint64_t i, int b) {
+    double inverse = 1.0 / b, factor = inverse, x = 0.0;
+    while (i > 0) {
+        x += (i % b) * factor;
+        i /= b;
+        factor *= inverse;
+    }
+    return x;
+}
+
+// Sobol primitive polynomials (degree s, coefficients a) and initial direction numbers m
+// for dimensions 2..20, from Joe and Kuo; dimension 1 is the van der Corput sequence
+static const struct {
+    int s, a;
+    int m[7];
+} sobol_table[MAX_DIMENSIONS - 1] = {
+    {1, 0, {1}}, {2, 1, {1, 3}}, {3, 1, {1, 3, 1}}, {3, 2, {1, 1, 1}}, {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}}, {5, 2, {1, 1, 5, 5, 17}}, {5, 4, {1, 1, 5, 5, 5}}, {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}}, {5, 13, {1, 1, 1, 3, 11}}, {5, 14, {1, 3, 5, 5, 31}}, {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}}, {6, 16, {1, 3, 1, 13, 27, 49}}, {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}}, {6, 25, {1, 1, 5, 5, 19, 61}}, {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+};
+
+// Direction numbers V[d][k], scaled to 32 bits, built on first use
+static uint32_t sobol_v[MAX_DIMENSIONS][32];
+static int sobol_ready = 0;
+
+static void sobol_build(void) {
+    for (int k = 0; k < 32; k++) {
+        sobol_v[0][k] = 1u << (31 - k);
+    }
+    for (int d = 1; d < MAX_DIMENSIONS; d++) {
+        int s = sobol_table[d - 1].s, a = sobol_table[d - 1].a;
+        for (int k = 0; k < s; k++) {
+            sobol_v[d][k] = (uint32_t)sobol_table[d - 1].m[k] << (31 - k);
+        }
+        for (int k = s; k < 32; k++) {
+            uint32_t v = sobol_v[d][k - s] ^ (sobol_v[d][k - s] >> s);
+            for (int j = 1; j < s; j++) {
+                if ((a >> (s - 1 - j)) & 1) {
+                    v ^= sobol_v[d][k - j];
+                }
+            }
+            sobol_v[d][k] = v;
+        }
+    }
+}
+
+// Build the direction numbers once, even when called from several threads
+static void sobol_init(void) {
+    # ifdef _OPENMP
+    # pragma omp critical(sobol_init)
+    # endif
+    if (!sobol_ready) {
+        sobol_build();
+        sobol_ready = 1;
+    }
+}
+
+// Coordinate d of Sobol point i (Gray-code order), computed directly from i
+static inline uint32_t sobol_bits(uint64_t i, int d) {
+    uint64_t gray = i ^ (i >> 1);
+    uint32_t x = 0;
+    for (int k = 0; gray; k++, gray >>= 1) {
+        if (gray & 1) {
+            x ^= sobol_v[d][k];
+        }
+    }
+    return x;
+}
+
+// Point i of the chosen sequence in [0, 1)^d; replicate r selects the randomization
+// (a random shift mod 1 for Halton, a random digital shift for Sobol)
+static void sample_point(SamplingMethod method, uint64_t seed, int r, uint64_t i, int d, double u[]) {
+    for (int k = 0; k < d; k++) {
+        if (method == MONTE_CARLO) {
+            u[k] = random_uniform(seed, k, i);
+            continue;
+        }
+
+        // Random shift of replicate r, only needed by the quasi-random sequences
+        uint64_t shift = random_bits(seed, (uint64_t)r * MAX_DIMENSIONS + k, 0);
+        if (method == HALTON) {
+            double x = radical_inverse(i + 1, primes[k]) + (shift >> 11) * 0x1.0p-53;
+            u[k] = x >= 1.0 ? x - 1.0 : x;
+        } else {
+            u[k] = (sobol_bits(i, k) ^ (uint32_t)(shift >> 32)) * 0x1.0p-32;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sampling integrators
+// ---------------------------------------------------------------------------
+
+// Sum f over samples [first, first + count) of replicate r, block by block in a fixed order
+static void sample_sums(multi_function f, int d, const double a[], const double b[], SamplingMethod method,
+                        uint64_t seed, int r, long first, long count, double *sum, double *sum_squares) {
+    long blocks = (count + BLOCK - 1) / BLOCK;
+    double *partial = malloc(2 * blocks * sizeof(double));
+    if (!partial) {
+        *sum = *sum_squares = NAN;
+        return;
+    }
+
+    # ifdef _OPENMP
+    # pragma omp parallel for schedule(dynamic, 1)
+    # endif
+    for (long blk = 0; blk < blocks; blk++) {
+        double u[MAX_DIMENSIONS], x[MAX_DIMENSIONS], s = 0.0, s2 = 0.0;
+        long end = (blk + 1) * BLOCK < count ? (blk + 1) * BLOCK : count;
+        for (long i = blk * BLOCK; i < end; i++) {
+            sample_point(method, seed, r, first + i, d, u);
+            for (int k = 0; k < d; k++) {
+                x[k] = a[k] + (b[k] - a[k]) * u[k];
+            }
+            double fx = f(x, d);
+            s += fx;
+            s2 += fx * fx;
+        }
+        partial[2 * blk] = s;
+        partial[2 * blk + 1] = s2;
+    }
+
+    *sum = *sum_squares = 0.0;
+    for (long blk = 0; blk < blocks; blk++) {
+        *sum += partial[2 * blk];
+        *sum_squares += partial[2 * blk + 1];
+    }
+    free(partial);
+}
+
+// Monte Carlo or randomized QMC. Samples are added in doubling rounds until the standard
+// error falls below max(abs_tol, rel_tol * |value|) or max_samples evaluations of f (over
+// all the replicates of a QMC rule) are used.
+CubatureResult sampling_integrate(multi_function f, int d, const double a[], const double b[], SamplingMethod method,
+                                  uint64_t seed, double abs_tol, double rel_tol, long max_samples) {
+    if (method == SOBOL) {
+        sobol_init();
+    }
+
+    double volume = 1.0;
+    for (int k = 0; k < d; k++) {
+        volume *= b[k] - a[k];
+    }
+
+    CubatureResult result = {NAN, NAN, 0};
+    int replicates = method == MONTE_CARLO ? 1 : REPLICATES;
+    double sums[REPLICATES] = {0}, sum_squares = 0.0;
+    long n = 0, step = BLOCK, limit = max_samples / replicates; // Samples per replicate
+
+    while (n < limit) {
+        if (n + step > limit) {
+            step = limit - n;
+        }
+        for (int r = 0; r < replicates; r++) {
+            double s, s2;
+            sample_sums(f, d, a, b, method, seed, r, n, step, &s, &s2);
+            sums[r] += s;
+            sum_squares += s2;
+        }
+        n += step;
+        result.evaluations = n * replicates;
+
+        if (method == MONTE_CARLO) {
+            // Standard error of the sample mean
+            double mean = sums[0] / n;
+            double variance = (sum_squares / n - mean * mean) * n / (n - 1.0);
+            result.value = volume * mean;
+            result.error = volume * sqrt(fmax(variance, 0.0) / n);
+        } else {
+            // Spread of the independently randomized replicates
+            double mean = 0.0, variance = 0.0;
+            for (int r = 0; r < replicates; r++) {
+                mean += sums[r] / n;
+            }
+            mean /= replicates;
+            for (int r = 0; r < replicates; r++) {
+                variance += (sums[r] / n - mean) * (sums[r] / n - mean);
+            }
+            variance /= replicates - 1;
+            result.value = volume * mean;
+            result.error = volume * sqrt(variance / replicates);
+        }
+
+        if (result.error <= fmax(abs_tol, rel_tol * fabs(result.value))) {
+            break;
+        }
+        step = n; // Double the sample count
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Tensor-product and sparse-grid rules
+// ---------------------------------------------------------------------------
+
+// Tensor product of the 1-D rules rules[k] (one per dimension)
+static double tensor_product(multi_function f, int d, const double a[], const double b[], const GaussRule *rules[],
+                             long *evaluations) {
+    long total = 1;
+    double scale = 1.0;
+    for (int k = 0; k < d; k++) {
+        total *= rules[k]->n;
+        scale *= 0.5 * (b[k] - a[k]);
+    }
+
+    double sum = 0.0;
+    # ifdef _OPENMP
+    # pragma omp parallel for reduction(+ : sum) schedule(static)
+    # endif
+    for (long index = 0; index < total; index++) {
+        double x[MAX_DIMENSIONS], w = 1.0;
+        long rest = index;
+        for (int k = 0; k < d; k++) {
+            int i = rest % rules[k]->n;
+            rest /= rules[k]->n;
+            x[k] = 0.5 * (a[k] + b[k]) + 0.5 * (b[k] - a[k]) * rules[k]->x[i];
+            w *= rules[k]->w[i];
+        }
+        sum += w * f(x, d);
+    }
+
+    *evaluations += total;
+    return sum * scale;
+}
+
+// Tensor-product Gauss-Legendre with n points per dimension
+CubatureResult tensor_integrate(multi_function f, int d, const double a[], const double b[], int n) {
+    CubatureResult result = {NAN, NAN, 0};
+    const GaussRule *rules[MAX_DIMENSIONS];
+    for (int k = 0; k < d; k++) {
+        rules[k] = gauss_rule(GAUSS_LEGENDRE, n);
+        if (!rules[k]) {
+            return result;
+        }
+    }
+    result.value = tensor_product(f, d, a, b, rules, &result.evaluations);
+    return result;
+}
+
+// Level l of the 1-D rule family used by the sparse grid: 2l - 1 Gauss-Legendre points
+static const GaussRule *smolyak_rule(int level) {
+    return gauss_rule(GAUSS_LEGENDRE, 2 * level - 1);
+}
+
+static double binomial(int n, int k) {
+    double c = 1.0;
+    for (int i = 1; i <= k; i++) {
+        c = c * (n - k + i) / i;
+    }
+    return c;
+}
+
+// Add every tensor term with levels l[k] >= 1, sum |l| in [low, high]
+static void smolyak_terms(multi_function f, int d, const double a[], const double b[], int levels[], int k, int used,
+                          int low, int high, double *sum, long *evaluations) {
+    if (k == d) {
+        if (used < low) {
+            return;
+        }
+        const GaussRule *rules[MAX_DIMENSIONS];
+        for (int j = 0; j < d; j++) {
+            rules[j] = smolyak_rule(levels[j]);
+        }
+        int q = high - used; // Combination coefficient (-1)^q C(d - 1, q)
+        *sum += (q % 2 ? -1.0 : 1.0) * binomial(d - 1, q) * tensor_product(f, d, a, b, rules, evaluations);
+        return;
+    }
+    for (int l = 1; used + l + (d - k - 1) <= high; l++) {
+        levels[k] = l;
+        smolyak_terms(f, d, a, b, levels, k + 1, used + l, low, high, sum, evaluations);
+    }
+}
+
+// Smolyak sparse grid of the given level (level 1 is the midpoint rule); the error is
+// estimated by comparing with the previous level
+CubatureResult smolyak_integrate(multi_function f, int d, const double a[], const double b[], int level) {
+    CubatureResult result = {0.0, NAN, 0};
+    int levels[MAX_DIMENSIONS];
+    double previous = NAN;
+
+    for (int l = 1; l <= level; l++) {
+        double sum = 0.0;
+        int high = l + d - 1, low = high - d + 1 > d ? high - d + 1 : d;
+        smolyak_terms(f, d, a, b, levels, 0, 0, low, high, &sum, &result.evaluations);
+        previous = result.value;
+        result.value = sum;
+    }
+    result.error = level > 1 ? fabs(result.value - previous) : NAN;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Driver code
+// ---------------------------------------------------------------------------
+
+// Test integrand: exp(-|x|^2), separable so the exact value is known
+double gaussian(const double x[], int d) {
+    double r2 = 0.0;
+    for (int k = 0; k < d; k++) {
+        r2 += x[k] * x[k];
+    }
+    return exp(-r2);
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_result(const char *name, CubatureResult r, double exact, double elapsed) {
+    printf("%-24s %.12f  error %9.2e  estimate %9.2e  %10ld evaluations  %7.3f s\n", name, r.value,
+           fabs(r.value - exact), r.error, r.evaluations, elapsed);
+}
+
+// Main function
+int main() {
+    int dimensions[] = {2, 5, 10, 20};
+    double a[MAX_DIMENSIONS], b[MAX_DIMENSIONS];
+    double tolerance = 1e-6;
+
+    for (int k = 0; k < MAX_DIMENSIONS; k++) {
+        a[k] = 0.0;
+        b[k] = 1.0;
+    }
+
+    for (int t = 0; t < 4; t++) {
+        int d = dimensions[t];
+        double exact = pow(0.5 * sqrt(M_PI) * erf(1.0), d);
+        double start;
+        CubatureResult r;
+
+        printf("\nexp(-|x|^2) over [0, 1]^%d, exact %.12f, tolerance %.0e\n", d, exact, tolerance);
+        printf("----------------------------------------------------------------------------------------------------------\n");
+
+        if (d <= 5) {
+            start = wall_time();
+            r = tensor_integrate(gaussian, d, a, b, 6);
+            print_result("Tensor Gauss-Legendre 6", r, exact, wall_time() - start);
+        }
+
+        start = wall_time();
+        r = smolyak_integrate(gaussian, d, a, b, d <= 10 ? 5 : 4);
+        print_result("Smolyak sparse grid", r, exact, wall_time() - start);
+
+        const char *names[] = {"Monte Carlo", "Halton QMC", "Sobol QMC"};
+        for (SamplingMethod method = MONTE_CARLO; method <= SOBOL; method++) {
+            start = wall_time();
+            r = sampling_integrate(gaussian, d, a, b, method, 2024, tolerance, 0.0, MAX_SAMPLES);
+            print_result(names[method], r, exact, wall_time() - start);
+        }
+        printf("----------------------------------------------------------------------------------------------------------\n");
+    }
+
+    gauss_free_cache();
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// Batched integration of a parameterized integrand family f(x; p) over one shared grid
+// The abscissae and composite weights are computed once. The integrand is called once per
+// tile of abscissae and block of parameter sets; parameters are stored as structure of
+// arrays (params[k][j] is parameter k of set j) so the innermost loops run over j.
+// Compile: gcc -O3 -march=native -fopenmp -ffast-math 08-batched-integration.c -o batched -lm
+// (-ffast-math lets GCC use the vector exp and cos of glibc in the SIMD loops)
+
+# define N 1000          // Number of subintervals
+# define SETS 20000      // Parameter sets in the demo
+# define X_TILE 32       // Abscissae per call of the family
+# define SET_BLOCK 256   // Parameter sets per call of the family
+# define MAX_PARAMS 16    // Parameters per set
+
+// Composite rule used on the shared grid
+typedef enum {
+    TRAPEZOIDAL = 1,
+    SIMPSON_13,
+    SIMPSON_38
+} CompositeRule;
+
+// Evaluates fx[i * sets + j] = f(x[i]; params[0][j], params[1][j], ...) for i < nx, j < sets
+typedef void (*family_function)(const double x[], int nx, const double *const params[], int sets, double fx[]);
+
+// Abscissae and weights (including h) of the composite rule; returns the number of points,
+// or 0 if n is invalid. n is rounded up as in 01-numerical-integration.c.
+int composite_weights(CompositeRule rule, double a, double b, int n, double x[], double w[]) {
+    if (rule == SIMPSON_13 && n % 2 != 0) {
+        n++; // n must be even for Simpson's rule
+    }
+    if (rule == SIMPSON_38 && n % 3 != 0) {
+        n += 3 - (n % 3); // n must be a multiple of 3 for Simpson's 3/8 rule
+    }
+    if (n <= 0) {
+        return 0;
+    }
+
+    double h = (b - a) / n;
+    for (int i = 0; i <= n; i++) {
+        x[i] = a + i * h;
+        if (rule == TRAPEZOIDAL) {
+            w[i] = h;
+        } else if (rule == SIMPSON_13) {
+            w[i] = (i % 2 == 0 ? 2 : 4) * h / 3;
+        } else {
+            w[i] = (i % 3 == 0 ? 2 : 3) * h * 3 / 8;
+        }
+    }
+    w[0] = w[n] = rule == TRAPEZOIDAL ? h / 2 : rule == SIMPSON_13 ? h / 3 : h * 3 / 8;
+    return n + 1;
+}
+
+// Integrate the family over [a, b] for every parameter set at once.
+// params holds num_params arrays of length sets; result[j] receives the integral for set j.
+// Returns 0, or -1 on invalid n, too many parameters or allocation failure.
+int integrate_family(family_function f, const double *const params[], int num_params, long sets, double a, double b,
+                     int n, CompositeRule rule, double result[]) {
+    double *x = malloc((n + 4) * sizeof(double));
+    double *w = malloc((n + 4) * sizeof(double));
+    int points = x && w && num_params <= MAX_PARAMS ? composite_weights(rule, a, b, n, x, w) : 0;
+    int failed = points == 0;
+
+    # ifdef _OPENMP
+    # pragma omp parallel for schedule(dynamic, 1) reduction(| : failed)
+    # endif
+    for (long j0 = 0; j0 < (points ? sets : 0); j0 += SET_BLOCK) {
+        int count = sets - j0 < SET_BLOCK ? (int)(sets - j0) : SET_BLOCK;
+        const double *block[MAX_PARAMS];
+        double sum[SET_BLOCK] = {0};
+        double *fx = malloc((size_t)X_TILE * SET_BLOCK * sizeof(double));
+
+        if (!fx) {
+            failed = 1;
+            free(fx);
+            continue;
+        }
+        for (int k = 0; k < num_params; k++) {
+            block[k] = params[k] + j0;
+        }
+
+        for (int i0 = 0; i0 < points; i0 += X_TILE) {
+            int nx = points - i0 < X_TILE ? points - i0 : X_TILE;
+            f(x + i0, nx, block, count, fx);
+            for (int i = 0; i < nx; i++) {
+                double wi = w[i0 + i];
+                # ifdef _OPENMP
+                # pragma omp simd
+                # endif
+                for (int j = 0; j < count; j++) {
+                    sum[j] += wi * fx[i * count + j];
+                }
+            }
+        }
+
+        for (int j = 0; j < count; j++) {
+            result[j0 + j] = sum[j];
+        }
+        free(fx);
+    }
+
+    free(x);
+    free(w);
+    return failed ? -1 : 0;
+}
+
+// Example family: f(x; A, k, c) = A e^(-k x) cos(c x)
+void damped_cosine(const double x[], int nx, const double *const params[], int sets, double fx[]) {
+    const double *A = params[0], *k = params[1], *c = params[2];
+    for (int i = 0; i < nx; i++) {
+        # ifdef _OPENMP
+        # pragma omp simd
+        # endif
+        for (int j = 0; j < sets; j++) {
+            fx[i * sets + j] = A[j] * exp(-k[j] * x[i]) * cos(c[j] * x[i]);
+        }
+    }
+}
+
+// Exact integral of the example family over [0, b]
+double damped_cosine_exact(double A, double k, double c, double b) {
+    return A * (k - exp(-k * b) * (k * cos(c * b) - c * sin(c * b))) / (k * k + c * c);
+}
+
+// Function to calculate the integral of a function using Simpson's 1/3 rule (as in 01-numerical-integration.c)
+double simpsons_13_rule(double (*f)(double), double a, double b, int n) {
+    if (n % 2 != 0) {
+        n++; // n must be even for Simpson's rule
+    }
+    double h = (b - a) / n;
+    double sum = f(a) + f(b);
+
+    for (int i = 1; i < n; i++) {
+        if (i % 2 == 0) {
+            sum += 2 * f(a + i * h);
+        } else {
+            sum += 4 * f(a + i * h);
+        }
+    }
+
+    return sum * h / 3;
+}
+
+// Parameters of the set being integrated one at a time
+double current_A, current_k, current_c;
+
+double single_function(double x) {
+    return current_A * exp(-current_k * x) * cos(current_c * x);
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Main function
+int main() {
+    double a = 0.0, b = 2.0;
+    double *A = malloc(SETS * sizeof(double));
+    double *k = malloc(SETS * sizeof(double));
+    double *c = malloc(SETS * sizeof(double));
+    double *batched = malloc(SETS * sizeof(double));
+    double *one_by_one = malloc(SETS * sizeof(double));
+    if (!A || !k || !c || !batched || !one_by_one) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+
+    for (int j = 0; j < SETS; j++) {
+        A[j] = 1.0 + (j % 7);
+        k[j] = 0.1 + 0.001 * j / 10;
+        c[j] = 1.0 + 10.0 * j / SETS;
+    }
+
+    // One call of simpsons_13_rule per parameter set
+    double start = wall_time();
+    for (int j = 0; j < SETS; j++) {
+        current_A = A[j];
+        current_k = k[j];
+        current_c = c[j];
+        one_by_one[j] = simpsons_13_rule(single_function, a, b, N);
+    }
+    double single_time = wall_time() - start;
+
+    // All parameter sets on the shared grid
+    const double *params[] = {A, k, c};
+    start = wall_time();
+    if (integrate_family(damped_cosine, params, 3, SETS, a, b, N, SIMPSON_13, batched) != 0) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    double batched_time = wall_time() - start;
+
+    double max_difference = 0.0, max_error = 0.0;
+    for (int j = 0; j < SETS; j++) {
+        max_difference = fmax(max_difference, fabs(batched[j] - one_by_one[j]));
+        max_error = fmax(max_error, fabs(batched[j] - damped_cosine_exact(A[j], k[j], c[j], b)));
+    }
+
+    printf("%d integrals of A e^(-kx) cos(cx) on [%.1f, %.1f], Simpson 1/3 with n = %d\n", SETS, a, b, N);
+    printf("------------------------------------------------------------------\n");
+    printf("One call per set: %.3f s\n", single_time);
+    printf("Batched:          %.3f s (%.1fx faster)\n", batched_time, single_time / batched_time);
+    printf("Max difference between the two: %.2e\n", max_difference);
+    printf("Max error against the exact integrals: %.2e\n", max_error);
+    printf("------------------------------------------------------------------\n");
+
+    free(A);
+    free(k);
+    free(c);
+    free(batched);
+    free(one_by_one);
+
+    return 0;
+}
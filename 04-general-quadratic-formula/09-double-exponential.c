@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <math.h>
+#include "../common/double_exponential.h"
+
+// tanh-sinh, exp-sinh and sinh-sinh quadrature on integrands with endpoint singularities
+// and infinite ranges, against the trapezoidal rule of 01-numerical-integration.c
+
+# define TOLERANCE 1e-14
+# define N 1000000 // Subintervals for the trapezoidal rule
+
+// Function to calculate the integral of a function using the trapezoidal rule (as in 01-numerical-integration.c)
+double trapezoidal_rule(double (*f)(double), double a, double b, int n) {
+    double h = (b - a) / n;
+    double sum = 0.5 * (f(a) + f(b));
+
+    for (int i = 1; i < n; i++) {
+        sum += f(a + i * h);
+    }
+
+    return sum * h;
+}
+
+// Test integrands
+double inverse_sqrt(double x) { return 1 / sqrt(x); }            // [0, 1]: 2
+double logarithm(double x) { return log(x); }                    // [0, 1]: -1
+double almost_reciprocal(double x) { return pow(x, -0.9); }      // [0, 1]: 10
+double semicircle(double x) { return sqrt(1 - x * x); }          // [-1, 1]: pi/2
+double gamma_half(double x) { return exp(-x) / sqrt(x); }        // [0, inf): sqrt(pi)
+double lorentzian(double x) { return 1 / (1 + x * x); }          // [0, inf): pi/2, (-inf, inf): pi
+double gaussian(double x) { return exp(-x * x); }                // (-inf, inf): sqrt(pi)
+
+static void print_result(const char *name, QuadratureResult r, int status, double exact) {
+    printf("%-28s %20.16f  error %9.2e  %5ld evaluations%s\n", name, r.value, fabs(r.value - exact), r.evaluations,
+           status == 1 ? " (max level)" : "");
+}
+
+// Main function
+int main() {
+    QuadratureResult r;
+    int status;
+
+    struct {
+        const char *name;
+        double (*f)(double);
+        double a, b, exact;
+    } finite[] = {
+        {"1/sqrt(x) on [0, 1]", inverse_sqrt, 0.0, 1.0, 2.0},
+        {"log(x) on [0, 1]", logarithm, 0.0, 1.0, -1.0},
+        {"x^-0.9 on [0, 1]", almost_reciprocal, 0.0, 1.0, 10.0},
+        {"sqrt(1 - x^2) on [-1, 1]", semicircle, -1.0, 1.0, M_PI_2},
+    };
+
+    printf("Finite intervals, tanh-sinh vs trapezoidal rule with n = %d\n", N);
+    printf("------------------------------------------------------------------------------------------\n");
+    for (int t = 0; t < 4; t++) {
+        status = tanh_sinh(finite[t].f, finite[t].a, finite[t].b, TOLERANCE, TOLERANCE, &r);
+        if (status < 0) {
+            printf("Memory allocation failed.\n");
+            return 1;
+        }
+        print_result(finite[t].name, r, status, finite[t].exact);
+
+        double trapezoid = trapezoidal_rule(finite[t].f, finite[t].a, finite[t].b, N);
+        printf("%-28s %20.16f  error %9.2e  %5s evaluations\n", "  trapezoidal rule", trapezoid,
+               fabs(trapezoid - finite[t].exact), "1e6");
+    }
+    printf("------------------------------------------------------------------------------------------\n\n");
+
+    printf("Infinite intervals\n");
+    printf("------------------------------------------------------------------------------------------\n");
+    status = exp_sinh(gamma_half, 0.0, TOLERANCE, TOLERANCE, &r);
+    print_result("e^-x/sqrt(x) on [0, inf)", r, status, sqrt(M_PI));
+    status = exp_sinh(lorentzian, 0.0, TOLERANCE, TOLERANCE, &r);
+    print_result("1/(1 + x^2) on [0, inf)", r, status, M_PI_2);
+    status = sinh_sinh(gaussian, TOLERANCE, TOLERANCE, &r);
+    print_result("e^(-x^2) on (-inf, inf)", r, status, sqrt(M_PI));
+    status = sinh_sinh(lorentzian, TOLERANCE, TOLERANCE, &r);
+    print_result("1/(1 + x^2) on (-inf, inf)", r, status, M_PI);
+    printf("------------------------------------------------------------------------------------------\n");
+
+    de_free_tables();
+
+    return 0;
+}
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "../common/integration.h"
+#include "../common/gauss_kronrod.h"
+#include "../common/gauss_legendre.h"
+#include "../common/romberg.h"
+#include "../common/double_exponential.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Quadrature benchmark: every integrator on a catalogue of test integrands
+// Reports the absolute error, evaluations of f, ns per evaluation and time per integral,
+// optionally as JSON, and compares against a stored baseline.
+// Compile: gcc -O2 10-quadrature-benchmark.c -o quadrature-benchmark -lm
+//          (serial on purpose, so evaluation counts and per-evaluation times are comparable;
+//          a -fopenmp build is limited to one thread)
+// Usage:   ./quadrature-benchmark [--json file] [--baseline file] [--check-time]
+//          Exits with status 2 when a regression against the baseline is found. Errors,
+//          evaluation counts and convergence are always compared; times only with
+//          --check-time, since they depend on the machine the baseline was recorded on.
+
+# define MIN_TIME 0.02        // Seconds each measurement is repeated for
+# define ERROR_FACTOR 10.0    // Allowed growth of the error over the baseline
+# define ERROR_FLOOR 1e-14    // Errors below this are never a regression
+# define EVALUATION_FACTOR 1.1
+# define TIME_FACTOR 3.0      // Timing is noisy; only large slowdowns are flagged
+# define MAX_RECORDS 128
+
+// One integrator of the catalogue
+typedef struct {
+    const char *name;
+    double (*integrate)(double (*f)(double), double a, double b);
+} Integrator;
+
+// One test integrand
+typedef struct {
+    const char *name;
+    const char *kind;
+    double (*f)(double);
+    double a, b, exact;
+} Integrand;
+
+// One measurement
+typedef struct {
+    char integrator[64];
+    char integrand[64];
+    double error;     // NAN when the result is not finite
+    long evaluations;
+    int status;       // Of the integrator: 0 converged, 1 stopped at its limit (levels, intervals)
+    double ns_per_evaluation;
+    double time;      // Seconds per integral
+} Record;
+
+// ---------------------------------------------------------------------------
+// Integrand catalogue (each call is counted; the counter is why the benchmark runs on one thread)
+// ---------------------------------------------------------------------------
+
+long evaluations = 0;
+
+double smooth(double x) { evaluations++; return exp(x); }
+double oscillatory(double x) { evaluations++; return cos(50 * x); }
+double peaked(double x) { evaluations++; return 1 / (1e-4 + (x - 0.3) * (x - 0.3)); }
+double singular(double x) { evaluations++; return 1 / sqrt(x); }
+double reciprocal(double x) { evaluations++; return 1 / x; }
+
+static const Integrand integrands[] = {
+    {"exp(x) [0,1]", "smooth", smooth, 0.0, 1.0, M_E - 1.0},
+    {"1/x [1,2]", "smooth", reciprocal, 1.0, 2.0, M_LN2},
+    {"cos(50x) [0,1]", "oscillatory", oscillatory, 0.0, 1.0, 0.0}, // exact set in main (sin(50) / 50)
+    {"1/(1e-4+(x-0.3)^2) [0,1]", "peaked", peaked, 0.0, 1.0, 0.0}, // exact set in main
+    {"1/sqrt(x) [0,1]", "singular", singular, 0.0, 1.0, 2.0},
+};
+
+// ---------------------------------------------------------------------------
+// Integrators with their settings (adaptive ones report their status in integrator_status)
+// ---------------------------------------------------------------------------
+
+int integrator_status = 0;
+
+double run_trapezoidal(double (*f)(double), double a, double b) { return trapezoidal_parallel(f, a, b, 1000); }
+double run_simpson_13(double (*f)(double), double a, double b) { return simpsons_13_parallel(f, a, b, 1000); }
+double run_simpson_38(double (*f)(double), double a, double b) { return simpsons_38_parallel(f, a, b, 1000); }
+
+double run_romberg(double (*f)(double), double a, double b) {
+    RombergState state;
+    romberg_init(&state, f, a, b);
+    integrator_status = romberg_integrate(&state, 1e-10, 1e-10, 20);
+    return romberg_value(&state);
+}
+
+double run_gauss_kronrod(double (*f)(double), double a, double b) {
+    QuadratureResult result;
+    integrator_status = gauss_kronrod(f, a, b, 1e-10, 1e-10, 1000, &result);
+    return integrator_status < 0 ? NAN : result.value;
+}
+
+double run_gauss_legendre(double (*f)(double), double a, double b) {
+    const GaussRule *rule = gauss_rule(GAUSS_LEGENDRE, 8);
+    return rule ? gauss_composite(rule, f, a, b, 16) : NAN;
+}
+
+double run_tanh_sinh(double (*f)(double), double a, double b) {
+    QuadratureResult result;
+    integrator_status = tanh_sinh(f, a, b, 1e-12, 1e-12, &result);
+    return integrator_status < 0 ? NAN : result.value;
+}
+
+static const Integrator integrators[] = {
+    {"trapezoidal n=1000", run_trapezoidal},
+    {"simpson 1/3 n=1000", run_simpson_13},
+    {"simpson 3/8 n=1000", run_simpson_38},
+    {"romberg tol=1e-10", run_romberg},
+    {"gauss-kronrod tol=1e-10", run_gauss_kronrod},
+    {"gauss-legendre 8x16", run_gauss_legendre},
+    {"tanh-sinh tol=1e-12", run_tanh_sinh},
+};
+
+// ---------------------------------------------------------------------------
+// Measurement, JSON and baseline
+// ---------------------------------------------------------------------------
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+Record measure(const Integrator *integrator, const Integrand *integrand) {
+    Record r;
+    snprintf(r.integrator, sizeof(r.integrator), "%s", integrator->name);
+    snprintf(r.integrand, sizeof(r.integrand), "%s", integrand->name);
+
+    evaluations = 0;
+    integrator_status = 0;
+    double value = integrator->integrate(integrand->f, integrand->a, integrand->b);
+    r.evaluations = evaluations;
+    r.status = integrator_status;
+    r.error = isfinite(value) ? fabs(value - integrand->exact) : NAN;
+
+    // Repeat until the measurement is long enough to time
+    long repeats = 0;
+    double start = wall_time(), elapsed;
+    do {
+        integrator->integrate(integrand->f, integrand->a, integrand->b);
+        repeats++;
+        elapsed = wall_time() - start;
+    } while (elapsed < MIN_TIME);
+
+    r.time = elapsed / repeats;
+    r.ns_per_evaluation = r.evaluations > 0 ? 1e9 * r.time / r.evaluations : 0.0;
+    return r;
+}
+
+// Write the records as a JSON array, one object per line; non-finite errors become null
+int write_json(const char *path, const Record records[], int count) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("Error: cannot open %s for writing.\n", path);
+        return -1;
+    }
+
+    fprintf(file, "[\n");
+    for (int i = 0; i < count; i++) {
+        const Record *r = &records[i];
+        fprintf(file, "  {\"integrator\": \"%s\", \"integrand\": \"%s\", \"error\": ", r->integrator, r->integrand);
+        if (isnan(r->error)) {
+            fprintf(file, "null");
+        } else {
+            fprintf(file, "%.3e", r->error);
+        }
+        fprintf(file, ", \"evaluations\": %ld, \"ns_per_eval\": %.2f, \"time\": %.3e, \"status\": %d}%s\n",
+                r->evaluations, r->ns_per_evaluation, r->time, r->status, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "]\n");
+    return fclose(file);
+}
+
+// Read a file written by write_json() (status 0 when the file has none); returns the number of records or -1
+int read_json(const char *path, Record records[], int max_records) {
+    FILE *file = fopen(path, "r");
+    char line[512], error[32];
+    int count = 0;
+
+    if (!file) {
+        printf("Error: cannot open %s.\n", path);
+        return -1;
+    }
+    while (count < max_records && fgets(line, sizeof(line), file)) {
+        Record *r = &records[count];
+        r->status = 0;
+        if (sscanf(line, " {\"integrator\": \"%63[^\"]\", \"integrand\": \"%63[^\"]\", \"error\": %31[^,], "
+                         "\"evaluations\": %ld, \"ns_per_eval\": %lf, \"time\": %lf, \"status\": %d",
+                   r->integrator, r->integrand, error, &r->evaluations, &r->ns_per_evaluation, &r->time,
+                   &r->status) >= 6) {
+            r->error = strcmp(error, "null") == 0 ? NAN : atof(error);
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+// Compare against the baseline (times only with check_time); returns the number of regressions
+int check_baseline(const Record records[], int count, const Record baseline[], int baseline_count, int check_time) {
+    int regressions = 0;
+
+    printf("\nComparison with the baseline\n");
+    printf("------------------------------------------------------------------------------------------\n");
+    for (int i = 0; i < count; i++) {
+        const Record *r = &records[i], *b = NULL;
+        for (int j = 0; j < baseline_count && !b; j++) {
+            if (strcmp(baseline[j].integrator, r->integrator) == 0 && strcmp(baseline[j].integrand, r->integrand) == 0) {
+                b = &baseline[j];
+            }
+        }
+        if (!b) {
+            printf("NEW        %-24s %-26s\n", r->integrator, r->integrand);
+            continue;
+        }
+
+        if (!isnan(b->error) && (isnan(r->error) || (r->error > ERROR_FACTOR * b->error && r->error > ERROR_FLOOR))) {
+            printf("REGRESSION %-24s %-26s error %.2e -> %.2e\n", r->integrator, r->integrand, b->error, r->error);
+            regressions++;
+        }
+        if (r->evaluations > EVALUATION_FACTOR * b->evaluations) {
+            printf("REGRESSION %-24s %-26s evaluations %ld -> %ld\n", r->integrator, r->integrand, b->evaluations,
+                   r->evaluations);
+            regressions++;
+        }
+        if (r->status != 0 && b->status == 0) {
+            printf("REGRESSION %-24s %-26s stopped at its limit, converged in the baseline\n", r->integrator,
+                   r->integrand);
+            regressions++;
+        }
+        if (check_time && r->time > TIME_FACTOR * b->time) {
+            printf("REGRESSION %-24s %-26s time %.2e s -> %.2e s\n", r->integrator, r->integrand, b->time, r->time);
+            regressions++;
+        }
+    }
+    printf("%d regression(s) against %d baseline records\n", regressions, baseline_count);
+    printf("------------------------------------------------------------------------------------------\n");
+    return regressions;
+}
+
+// Main function
+int main(int argc, char const *argv[]) {
+    const char *json = NULL, *baseline_path = NULL;
+    int check_time = 0;
+    Record records[MAX_RECORDS], baseline[MAX_RECORDS];
+    Integrand catalogue[sizeof(integrands) / sizeof(integrands[0])];
+    int num_integrands = sizeof(integrands) / sizeof(integrands[0]);
+    int num_integrators = sizeof(integrators) / sizeof(integrators[0]);
+    int count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--check-time") == 0) {
+            check_time = 1;
+        } else {
+            printf("Usage: %s [--json file] [--baseline file] [--check-time]\n", argv[0]);
+            return 1;
+        }
+    }
+
+#ifdef _OPENMP
+    // The parallel rules would race on the evaluation counter and change the timings
+    omp_set_num_threads(1);
+#endif
+
+    memcpy(catalogue, integrands, sizeof(integrands));
+    catalogue[2].exact = sin(50.0) / 50;
+    catalogue[3].exact = 100 * (atan(70.0) + atan(30.0));
+
+    printf("%-24s %-26s %-12s %10s %10s %12s\n", "Integrator", "Integrand", "Kind", "Error", "Evals", "ns/eval");
+    printf("------------------------------------------------------------------------------------------------\n");
+    for (int i = 0; i < num_integrators; i++) {
+        for (int j = 0; j < num_integrands; j++) {
+            records[count] = measure(&integrators[i], &catalogue[j]);
+            const Record *r = &records[count++];
+            printf("%-24s %-26s %-12s %10.2e %10ld %12.2f%s\n", r->integrator, r->integrand, catalogue[j].kind, r->error,
+                   r->evaluations, r->ns_per_evaluation, r->status == 1 ? "  (limit reached)" : "");
+        }
+    }
+    printf("------------------------------------------------------------------------------------------------\n");
+
+    if (json && write_json(json, records, count) == 0) {
+        printf("Results written to %s\n", json);
+    }
+
+    int status = 0;
+    if (baseline_path) {
+        int baseline_count = read_json(baseline_path, baseline, MAX_RECORDS);
+        if (baseline_count < 0) {
+            status = 1;
+        } else if (check_baseline(records, count, baseline, baseline_count, check_time) > 0) {
+            status = 2;
+        }
+    }
+
+    gauss_free_cache();
+    de_free_tables();
+
+    return status;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../common/quadrature_plan.h"
+
+// Microbenchmark: per-call overhead of many small integrals with and without a plan
+// Compile: gcc -O2 11-integration-plan.c -o integration-plan -lm
+
+# define CALLS 1000000
+# define N 16       // Subintervals of the composite rules
+# define LEVELS 5   // Romberg levels (2^4 + 1 = 17 points)
+
+// Function to calculate the integral of a function using Simpson's 1/3 rule (as in 01-numerical-integration.c)
+double simpsons_13_rule(double (*f)(double), double a, double b, int n) {
+    if (n % 2 != 0) {
+        n++; // n must be even for Simpson's rule
+    }
+    double h = (b - a) / n;
+    double sum = f(a) + f(b);
+
+    for (int i = 1; i < n; i++) {
+        if (i % 2 == 0) {
+            sum += 2 * f(a + i * h);
+        } else {
+            sum += 4 * f(a + i * h);
+        }
+    }
+
+    return sum * h / 3;
+}
+
+// Romberg integration function (as in 06-rombergs-integration/01-rombergs-integration.c)
+double romberg(double (*func)(double), double a, double b, int n) {
+    double R[n][n];
+    int i, j, k;
+    double h = b - a;
+
+    for (i = 0; i < n; i++) {
+        int N_i = 1 << i; // 2^i
+        double sum = 0.0;
+        double step = h / N_i;
+        for (k = 1; k < N_i; k += 2) {
+            sum += func(a + k * step);
+        }
+        if (i == 0)
+            R[i][0] = (func(a) + func(b)) * h / 2.0;
+        else
+            R[i][0] = 0.5 * R[i-1][0] + sum * step;
+    }
+
+    for (i = 1; i < n; i++) {
+        for (j = 1; j <= i; j++) {
+            R[i][j] = R[i][j-1] + (R[i][j-1] - R[i-1][j-1]) / (pow(4, j) - 1);
+        }
+    }
+
+    return R[n-1][n-1];
+}
+
+// Example function to integrate
+double example_function(double x) {
+    return 1 / x;
+}
+
+// Batch version for quadrature_execute_batch()
+void example_batch(const double x[], double fx[], int n) {
+    for (int i = 0; i < n; i++) {
+        fx[i] = 1 / x[i];
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Main function
+int main() {
+    QuadraturePlan simpson, romberg_plan;
+    if (quadrature_plan_init(&simpson, PLAN_SIMPSON_13, N) != 0 || quadrature_plan_init(&romberg_plan, PLAN_ROMBERG, LEVELS) != 0) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+
+    // Many small integrals of 1/x over [1, b], b in (1, 3)
+    double results[5] = {0}, times[5], max_difference[2] = {0};
+    const char *names[] = {"simpsons_13_rule()", "plan, Simpson 1/3", "romberg()", "plan, Romberg", "plan, Romberg (batch)"};
+
+    for (int method = 0; method < 5; method++) {
+        double start = wall_time(), total = 0.0;
+        for (int c = 0; c < CALLS; c++) {
+            double b = 1.0 + 2.0 * (c + 1) / CALLS;
+            double value;
+            switch (method) {
+                case 0: value = simpsons_13_rule(example_function, 1.0, b, N); break;
+                case 1: value = quadrature_execute(&simpson, example_function, 1.0, b); break;
+                case 2: value = romberg(example_function, 1.0, b, LEVELS); break;
+                case 3: value = quadrature_execute(&romberg_plan, example_function, 1.0, b); break;
+                default: value = quadrature_execute_batch(&romberg_plan, example_batch, 1.0, b); break;
+            }
+            total += value;
+
+            // Plans must reproduce the direct results
+            if (method == 1) {
+                max_difference[0] = fmax(max_difference[0], fabs(value - simpsons_13_rule(example_function, 1.0, b, N)));
+            } else if (method == 3) {
+                max_difference[1] = fmax(max_difference[1], fabs(value - romberg(example_function, 1.0, b, LEVELS)));
+            }
+        }
+        times[method] = wall_time() - start;
+        results[method] = total;
+    }
+
+    // Timing of methods 1 and 3 includes the direct call used for checking; time them again alone
+    for (int method = 1; method <= 3; method += 2) {
+        const QuadraturePlan *plan = method == 1 ? &simpson : &romberg_plan;
+        double start = wall_time(), total = 0.0;
+        for (int c = 0; c < CALLS; c++) {
+            total += quadrature_execute(plan, example_function, 1.0, 1.0 + 2.0 * (c + 1) / CALLS);
+        }
+        times[method] = wall_time() - start;
+        results[method] = total;
+    }
+
+    printf("%d integrals of 1/x over [1, b]\n", CALLS);
+    printf("------------------------------------------------------------\n");
+    printf("%-24s %12s %18s\n", "Method", "ns per call", "Sum of results");
+    printf("------------------------------------------------------------\n");
+    for (int method = 0; method < 5; method++) {
+        printf("%-24s %12.1f %18.10f\n", names[method], 1e9 * times[method] / CALLS, results[method]);
+    }
+    printf("------------------------------------------------------------\n");
+    printf("Max difference from the direct calls: Simpson %.2e, Romberg %.2e\n", max_difference[0], max_difference[1]);
+
+    quadrature_plan_free(&simpson);
+    quadrature_plan_free(&romberg_plan);
+    gauss_free_cache();
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+# define _DEFAULT_SOURCE // madvise
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <math.h>
+# include <time.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include "../common/regression_stream.h"
+# include "../common/csv_pairs.h"
+
+// Streaming one-pass regression over data sets of any size
+// The (x, y) pairs are read once, in chunks, from
+//   - a binary file of interleaved doubles x0 y0 x1 y1 ... (memory-mapped), or
+//   - a CSV file with one "x,y" pair per line (read in blocks with csv_pairs.h, the next
+//     block is read by a second thread while the current one is parsed),
+// and accumulated into mergeable moments instead of being stored in arrays.
+// Compile: gcc -O3 -march=native -fopenmp 02-streaming-regression.c -o streaming-regression -lm
+// Usage:   ./streaming-regression [type file.bin | type file.csv]   (type 1-4 as in 01-regression-analysis.c;
+//          without a file, test data is generated and all four models are fitted)
+
+# define CHUNK_POINTS (1 << 20)   // Points fitted per chunk of the mapped file
+# define TEST_POINTS 4000000      // Rows in the generated test files
+
+// Fit a memory-mapped binary file of interleaved doubles; returns 0 or -1 on error
+int fit_binary(const char *path, RegressionType type, RegressionMoments *moments) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("Error: cannot open %s.\n", path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    if (st.st_size % (2 * sizeof(double)) != 0) {
+        printf("Error: %s is not a whole number of (x, y) pairs.\n", path);
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    const double *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        printf("Error: cannot map %s.\n", path);
+        return -1;
+    }
+    madvise((void *)data, st.st_size, MADV_SEQUENTIAL);
+
+    long points = st.st_size / (2 * sizeof(double));
+    long page = sysconf(_SC_PAGESIZE);
+    for (long start = 0; start < points; start += CHUNK_POINTS) {
+        long m = points - start < CHUNK_POINTS ? points - start : CHUNK_POINTS;
+
+        // Ask the kernel to read the next chunk while this one is fitted
+        long next = start + CHUNK_POINTS;
+        if (next < points) {
+            long offset = next * 2 * sizeof(double) / page * page;
+            long length = CHUNK_POINTS * 2 * sizeof(double);
+            if (offset + length > st.st_size) {
+                length = st.st_size - offset;
+            }
+            madvise((char *)data + offset, length, MADV_WILLNEED);
+        }
+
+        regression_stream_add(moments, type, data + 2 * start, m);
+    }
+
+    munmap((void *)data, st.st_size);
+    return 0;
+}
+
+// Moments and model filled by csv_read_pairs()
+typedef struct {
+    RegressionMoments *moments;
+    RegressionType type;
+} CsvFit;
+
+// Consumer for csv_read_pairs(): runs outside any parallel region, so the rows of each
+// block are split across all threads
+static void fit_pairs(void *context, const double *xy, long m) {
+    CsvFit *fit = context;
+    regression_stream_add(fit->moments, fit->type, xy, m);
+}
+
+// Fit a CSV file read in blocks; returns 0 or -1 on error
+int fit_csv(const char *path, RegressionType type, RegressionMoments *moments) {
+    CsvFit fit = {moments, type};
+    return csv_read_pairs(path, fit_pairs, &fit);
+}
+
+// Write TEST_POINTS rows of y = 3 x^1.5 with multiplicative noise, x in [1, 100]
+int write_test_files(const char *binary, const char *csv) {
+    FILE *fb = fopen(binary, "wb"), *fc = fopen(csv, "w");
+    if (!fb || !fc) {
+        printf("Error: cannot create the test files.\n");
+        if (fb) {
+            fclose(fb);
+        }
+        if (fc) {
+            fclose(fc);
+        }
+        return -1;
+    }
+
+    fprintf(fc, "x,y\n");
+    unsigned long long state = 42;
+    for (long i = 0; i < TEST_POINTS; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double noise = (double)(state >> 11) / 9007199254740992.0 - 0.5; // Uniform in [-0.5, 0.5)
+        double x = 1.0 + 99.0 * i / (TEST_POINTS - 1);
+        double xy[2] = {x, 3.0 * pow(x, 1.5) * exp(0.1 * noise)};
+        fwrite(xy, sizeof(double), 2, fb);
+        fprintf(fc, "%.17g,%.17g\n", xy[0], xy[1]);
+    }
+
+    fclose(fb);
+    return fclose(fc);
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Fit one file and print the equation in the format of 01-regression-analysis.c
+int report(const char *path, RegressionType type) {
+    RegressionMoments moments = {0};
+    size_t length = strlen(path);
+    int csv = length >= 4 && strcmp(path + length - 4, ".csv") == 0;
+    double m, c;
+    struct stat st;
+
+    if (type < LINEAR || type > POWER) {
+        printf("Invalid regression type.\n");
+        return -1;
+    }
+
+    double start = wall_time();
+    if ((csv ? fit_csv(path, type, &moments) : fit_binary(path, type, &moments)) != 0) {
+        return -1;
+    }
+    double elapsed = wall_time() - start;
+    stat(path, &st);
+
+    printf("\n%s (%s, %ld rows)\n", path, csv ? "CSV" : "binary", moments.n + moments.invalid);
+    if (moments.invalid > 0) {
+        printf("Error: %ld rows with x <= 0 or y <= 0, cannot take log for this regression.\n", moments.invalid);
+        return -1;
+    }
+    if (regression_moments_fit(&moments, &m, &c) != 0) {
+        printf("Error: at least two distinct x values are needed.\n");
+        return -1;
+    }
+
+    switch (type) {
+        case LINEAR:
+            printf("Linear Regression: y = (%.4lf)x + (%.4lf)\n", m, c);
+            break;
+        case EXPONENTIAL:
+            printf("Exponential Regression: y = (%.4lf) * exp(%.4lf * x)\n", exp(c), m);
+            break;
+        case LOGARITHMIC:
+            printf("Logarithmic Regression: y = (%.4lf) + (%.4lf) * ln(x)\n", c, m);
+            break;
+        case POWER:
+            printf("Power Regression: y = (%.4lf) * x^(%.4lf)\n", exp(c), m);
+            break;
+    }
+    printf("Time: %.3f s (%.1f MB/s)\n", elapsed, st.st_size / elapsed / 1e6);
+    return 0;
+}
+
+// Driver function
+int main(int argc, char const *argv[]) {
+    if (argc > 2) {
+        return report(argv[2], (RegressionType)atoi(argv[1])) != 0;
+    }
+    if (argc == 2) {
+        printf("Usage: %s [type file]\n", argv[0]);
+        return 1;
+    }
+
+    // No file given: generate y = 3 x^1.5 with noise, so the power model should give a = 3, b = 1.5
+    const char *binary = "regression.bin", *csv = "regression.csv";
+    if (write_test_files(binary, csv) != 0) {
+        return 1;
+    }
+    int status = 0;
+    for (int type = LINEAR; type <= POWER; type++) {
+        status |= report(binary, (RegressionType)type) != 0;
+    }
+    status |= report(csv, POWER) != 0;
+    remove(binary);
+    remove(csv);
+
+    return status;
+}
@@ -0,0 +1,116 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <math.h>
+# include <time.h>
+# include "../common/least_squares.h"
+
+// Multiple linear regression with many features and polynomial least squares
+// Rows are generated and appended block by block, as they would be read from a file,
+// so the full data set is never held in memory.
+// Compile: gcc -O3 -march=native -fopenmp 04-multiple-regression.c -o multiple-regression -lm
+
+# define FEATURES 100
+# define ROWS 2000000
+# define BLOCK_ROWS 50000   // Rows per append
+# define POINTS 1000000     // Points for the polynomial fit
+# define DEGREE 5
+
+// Uniform number in [-0.5, 0.5) from a 64-bit linear congruential generator
+static double uniform(unsigned long long *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double)(*state >> 11) / 9007199254740992.0 - 0.5;
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Driver function
+int main() {
+    double *X = malloc((size_t)BLOCK_ROWS * FEATURES * sizeof(double));
+    double *y = malloc(POINTS * sizeof(double));
+    double *x = malloc(POINTS * sizeof(double));
+    double beta_true[FEATURES], beta[FEATURES], intercept, r2;
+    LeastSquares ls;
+
+    if (!X || !y || !x || least_squares_init(&ls, FEATURES) != 0) {
+        printf("Memory allocation failed.\n");
+        free(X);
+        free(y);
+        free(x);
+        return 1;
+    }
+
+    // y = 5 + sum beta_j x_j + noise, features with offsets far from zero
+    unsigned long long state = 42;
+    for (int j = 0; j < FEATURES; j++) {
+        beta_true[j] = 2.0 * uniform(&state);
+    }
+
+    double generate_time = 0.0, start = wall_time();
+    for (long appended = 0; appended < ROWS; appended += BLOCK_ROWS) {
+        double t = wall_time();
+        for (long r = 0; r < BLOCK_ROWS; r++) {
+            double sum = 5.0;
+            for (int j = 0; j < FEATURES; j++) {
+                X[r * FEATURES + j] = 1000.0 * j + uniform(&state);
+                sum += beta_true[j] * X[r * FEATURES + j];
+            }
+            y[r] = sum + 0.01 * uniform(&state);
+        }
+        generate_time += wall_time() - t;
+
+        if (least_squares_append(&ls, X, y, BLOCK_ROWS) != 0) {
+            printf("Memory allocation failed.\n");
+            return 1;
+        }
+    }
+    double fit_time = wall_time() - start - generate_time;
+
+    if (least_squares_solve(&ls, beta, &intercept, &r2) != 0) {
+        printf("Error: the features are collinear.\n");
+        return 1;
+    }
+    double max_error = 0.0;
+    for (int j = 0; j < FEATURES; j++) {
+        max_error = fmax(max_error, fabs(beta[j] - beta_true[j]));
+    }
+    double flops = (double)ROWS * (FEATURES + 1) * (FEATURES + 2); // Upper triangle, multiply and add
+
+    printf("Multiple regression: %d rows, %d features, appended in blocks of %d\n", ROWS, FEATURES, BLOCK_ROWS);
+    printf("--------------------------------------------------------------\n");
+    printf("Max |beta - beta_true|: %.2e\n", max_error);
+    printf("Intercept: %.6f (true 5), R^2: %.10f\n", intercept, r2);
+    printf("Gram matrix: %.3f s (%.2f GFLOP/s)\n", fit_time, flops / fit_time / 1e9);
+    printf("--------------------------------------------------------------\n\n");
+
+    // Polynomial: y = 1 - 2x + 0.5x^3 + noise on [0, 10]
+    const double coef_true[DEGREE + 1] = {1.0, -2.0, 0.0, 0.5, 0.0, 0.0};
+    double coef[DEGREE + 1];
+    for (long i = 0; i < POINTS; i++) {
+        x[i] = 10.0 * i / (POINTS - 1);
+        y[i] = 1.0 - 2.0 * x[i] + 0.5 * x[i] * x[i] * x[i] + 0.1 * uniform(&state);
+    }
+
+    start = wall_time();
+    if (polynomial_fit(x, y, POINTS, DEGREE, coef, &r2) != 0) {
+        printf("Error: polynomial fit failed.\n");
+        return 1;
+    }
+    printf("Polynomial regression: degree %d, %d points, %.3f s\n", DEGREE, POINTS, wall_time() - start);
+    printf("--------------------------------------------------------------\n");
+    for (int k = 0; k <= DEGREE; k++) {
+        printf("x^%d: %12.6f (true %4.1f)\n", k, coef[k], coef_true[k]);
+    }
+    printf("R^2: %.10f\n", r2);
+    printf("--------------------------------------------------------------\n");
+
+    least_squares_free(&ls);
+    free(X);
+    free(y);
+    free(x);
+    return 0;
+}
@@ -0,0 +1,122 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <math.h>
+# include <time.h>
+# include "../common/regression_model.h"
+
+// Reentrant regression models and batch prediction
+// The four models are fitted concurrently (one per thread) into separate RegressionModel
+// values, then each predicts N points with predict_batch(), against the scalar prediction
+// of 01-regression-analysis.c that reads the globals and recomputes exp(intercept_c).
+// Compile: gcc -O3 -march=native -ffast-math -fopenmp 05-batch-prediction.c -o batch-prediction -lm
+//          (-ffast-math lets gcc vectorize exp, log and pow with glibc's libmvec)
+
+# define SIZE 20        // Data points per fit, as in 01-regression-analysis.c
+# define N 10000000     // Predictions per model
+
+static const char *model_names[] = {"Linear", "Exponential", "Logarithmic", "Power"};
+
+// Global variables for regression coefficients (as in 01-regression-analysis.c)
+double slope_m = 0.0, intercept_c = 0.0;
+
+// Prediction function for different regression types (as in 01-regression-analysis.c, without the messages)
+double regression_predict(double x, RegressionType type) {
+    switch(type) {
+        case LINEAR:
+            return slope_m * x + intercept_c;
+        case EXPONENTIAL:
+            return exp(intercept_c) * exp(slope_m * x); // y = a * exp(bx)
+        case LOGARITHMIC:
+            if (x <= 0) {
+                return NAN;
+            }
+            return intercept_c + slope_m * log(x); // y = a + b*ln(x)
+        case POWER:
+            if (x <= 0) {
+                return NAN;
+            }
+            return exp(intercept_c) * pow(x, slope_m); // y = a * x^b
+        default:
+            return NAN;
+    }
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Driver function
+int main() {
+    double x[SIZE], y[SIZE];
+    RegressionModel models[4];
+    int status[4];
+
+    // y = 0.5 x^2 sampled at x = 1 ... 20
+    for (int i = 0; i < SIZE; i++) {
+        x[i] = i + 1;
+        y[i] = 0.5 * x[i] * x[i];
+    }
+
+    // Fit all four models at the same time; each thread writes only its own model
+    # ifdef _OPENMP
+    # pragma omp parallel for
+    # endif
+    for (int k = 0; k < 4; k++) {
+        status[k] = regression_model_fit(x, y, SIZE, (RegressionType)(k + 1), &models[k]);
+    }
+
+    double *px = malloc(N * sizeof(double));
+    double *py = malloc(N * sizeof(double));
+    double *expected = malloc(N * sizeof(double));
+    if (!px || !py || !expected) {
+        printf("Memory allocation failed.\n");
+        free(px);
+        free(py);
+        free(expected);
+        return 1;
+    }
+    for (long i = 0; i < N; i++) {
+        px[i] = 1.0 + 19.0 * i / (N - 1);
+    }
+
+    printf("%d predictions per model on [1, 20]\n", N);
+    printf("--------------------------------------------------------------------------------\n");
+    printf("%-12s %14s %14s %10s %14s %14s\n", "Model", "Scalar (s)", "Batch (s)", "Speedup", "Max rel diff", "y(6)");
+    printf("--------------------------------------------------------------------------------\n");
+    for (int k = 0; k < 4; k++) {
+        if (status[k] != 0) {
+            printf("%-12s fit failed\n", model_names[k]);
+            continue;
+        }
+        RegressionType type = (RegressionType)(k + 1);
+
+        // Scalar prediction through the globals, as 01 does
+        slope_m = models[k].slope;
+        intercept_c = models[k].intercept;
+        double start = wall_time();
+        for (long i = 0; i < N; i++) {
+            expected[i] = regression_predict(px[i], type);
+        }
+        double scalar_time = wall_time() - start;
+
+        start = wall_time();
+        predict_batch(&models[k], px, py, N);
+        double batch_time = wall_time() - start;
+
+        double max_difference = 0.0;
+        for (long i = 0; i < N; i++) {
+            max_difference = fmax(max_difference, fabs(py[i] - expected[i]) / fabs(expected[i]));
+        }
+        printf("%-12s %14.4f %14.4f %9.1fx %14.2e %14.4f\n", model_names[k], scalar_time, batch_time,
+               scalar_time / batch_time, max_difference, regression_model_predict(&models[k], 6.0));
+    }
+    printf("--------------------------------------------------------------------------------\n");
+
+    free(px);
+    free(py);
+    free(expected);
+    return 0;
+}
@@ -0,0 +1,142 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <math.h>
+# include <time.h>
+# include "../common/levenberg_marquardt.h"
+
+// Nonlinear least squares with Levenberg-Marquardt
+// Exponential and power models fitted in y itself, against the log-linear fits of
+// 01-regression-analysis.c, plus a logistic model whose derivatives come from dual.h.
+// Compile: gcc -O3 -march=native -fopenmp 06-nonlinear-regression.c -o nonlinear-regression -lm
+
+# define N 1000000 // Points per data set
+
+// Normal number from a 64-bit linear congruential generator (Box-Muller)
+static double normal(unsigned long long *state) {
+    double u[2];
+    for (int k = 0; k < 2; k++) {
+        *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+        u[k] = ((*state >> 11) + 0.5) / 9007199254740992.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+// Logistic growth K / (1 + exp(-r (x - x0))), written once for automatic derivatives
+Dual logistic(double x, const Dual params[]) {
+    Dual growth = dual_exp(dual_mul(dual_neg(params[1]), dual_add_c(dual_neg(params[2]), x)));
+    return dual_div(params[0], dual_add_c(growth, 1.0));
+}
+
+// Wall clock time in seconds
+static double wall_time(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Fit one data set with the log-linear method and with Levenberg-Marquardt
+void compare(const char *title, RegressionType type, const double *x, const double *y, double a, double b) {
+    RegressionModel model;
+    LMResult r;
+    long positive = 0;
+
+    printf("%s, true a = %.4f, b = %.4f\n", title, a, b);
+    printf("--------------------------------------------------------------------------\n");
+
+    // Log-linear fit (as in 01): only possible on the points with y > 0
+    for (long i = 0; i < N; i++) {
+        positive += y[i] > 0;
+    }
+    double *px = malloc(positive * sizeof(double)), *py = malloc(positive * sizeof(double));
+    if (!px || !py) {
+        printf("Memory allocation failed.\n");
+        free(px);
+        free(py);
+        return;
+    }
+    for (long i = 0, j = 0; i < N; i++) {
+        if (y[i] > 0) {
+            px[j] = x[i];
+            py[j++] = y[i];
+        }
+    }
+    if (positive < N) {
+        printf("Log-linear:  %ld of %d points have y <= 0; 01 rejects the data, fitted without them\n", N - positive, N);
+    }
+    if (regression_model_fit(px, py, positive, type, &model) == 0) {
+        printf("Log-linear:           a = %9.6f, b = %9.6f\n", model.a, model.slope);
+    }
+    free(px);
+    free(py);
+
+    double start = wall_time();
+    int status = lm_fit(type, x, y, N, &model, &r);
+    double elapsed = wall_time() - start;
+    if (status < 0) {
+        printf("Levenberg-Marquardt failed.\n");
+    } else {
+        printf("Levenberg-Marquardt:  a = %9.6f, b = %9.6f  (RMSE %.4f, %d iterations, %ld passes, %.3f s)%s\n",
+               model.a, model.slope, r.rmse, r.iterations, r.evaluations, elapsed,
+               status == 1 ? " (max iterations)" : "");
+    }
+
+    // The same fit from a cold start a = 1, b = 0, to show what the warm start saves
+    LMModel cold = {2, type == EXPONENTIAL ? lm_exponential : lm_power, NULL};
+    double params[2] = {1.0, 0.0};
+    if (levenberg_marquardt(&cold, x, y, N, params, &r) >= 0) {
+        printf("Cold start (1, 0):    a = %9.6f, b = %9.6f  (%d iterations, %ld passes)\n", params[0], params[1],
+               r.iterations, r.evaluations);
+    }
+    printf("--------------------------------------------------------------------------\n\n");
+}
+
+// Driver function
+int main() {
+    double *x = malloc(N * sizeof(double)), *y = malloc(N * sizeof(double));
+    unsigned long long state = 42;
+
+    if (!x || !y) {
+        printf("Memory allocation failed.\n");
+        free(x);
+        free(y);
+        return 1;
+    }
+
+    // Exponential decay with additive noise: the tail crosses zero
+    for (long i = 0; i < N; i++) {
+        x[i] = 10.0 * i / (N - 1);
+        y[i] = 5.0 * exp(-0.5 * x[i]) + 0.05 * normal(&state);
+    }
+    compare("y = a exp(bx) + noise", EXPONENTIAL, x, y, 5.0, -0.5);
+
+    // Power law with additive noise
+    for (long i = 0; i < N; i++) {
+        x[i] = 1.0 + 9.0 * i / (N - 1);
+        y[i] = 3.0 * pow(x[i], 1.5) + 2.0 * normal(&state);
+    }
+    compare("y = a x^b + noise", POWER, x, y, 3.0, 1.5);
+
+    // Logistic growth, a user model with automatic derivatives
+    LMModel model = {3, NULL, logistic};
+    double params[3] = {8.0, 1.0, 4.0}; // K, r, x0: a rough guess
+    LMResult r;
+    for (long i = 0; i < N; i++) {
+        x[i] = 10.0 * i / (N - 1);
+        y[i] = 10.0 / (1.0 + exp(-1.5 * (x[i] - 5.0))) + 0.1 * normal(&state);
+    }
+    double start = wall_time();
+    int status = levenberg_marquardt(&model, x, y, N, params, &r);
+    printf("y = K / (1 + exp(-r (x - x0))) + noise, true K = 10, r = 1.5, x0 = 5 (dual.h derivatives)\n");
+    printf("--------------------------------------------------------------------------\n");
+    if (status < 0) {
+        printf("Levenberg-Marquardt failed.\n");
+    } else {
+        printf("Levenberg-Marquardt:  K = %.6f, r = %.6f, x0 = %.6f  (RMSE %.4f, %d iterations, %.3f s)%s\n", params[0],
+               params[1], params[2], r.rmse, r.iterations, wall_time() - start, status == 1 ? " (max iterations)" : "");
+    }
+    printf("--------------------------------------------------------------------------\n");
+
+    free(x);
+    free(y);
+    return 0;
+}
@@ -1,8 +1,17 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/expression.h"
+
+// Expression given on the command line, e.g. "x*exp(x)-cos(x)"
+Expression expression;
+int use_expression = 0;
 
 // Define the function to integrate here
 double f(double x) {
+    // Runtime expression, when one was given
+    if (use_expression)
+        return expr_eval(&expression, x, 0.0);
+
     // Example: integrate sin(x)
     return sin(x);
 }
@@ -37,10 +46,18 @@ double romberg(double (*func)(double), double a, double b, int n) {
     return R[n-1][n-1];
 }
 
-int main() {
+int main(int argc, char const *argv[]) {
     double a, b;
     int n;
 
+    // Use the function given as the first argument instead of the built-in one
+    if (argc > 1) {
+        if (expr_compile(&expression, argv[1]) != 0)
+            return 1;
+        use_expression = 1;
+        printf("Function: f(x) = %s\n", argv[1]);
+    }
+
     printf("Enter lower limit a: ");
     scanf("%lf", &a);
     printf("Enter upper limit b: ");
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <math.h>
+#include "../common/chebyshev.h"
+
+// Chebyshev proxy for an expensive integrand / equation
+// f is sampled once on Chebyshev points; Romberg integration and root finding then
+// query the cheap proxy instead of f.
+
+#define TOLERANCE 1e-13 // Relative size of the last kept Chebyshev coefficient
+#define MAX_DEGREE 4096
+
+int evaluations = 0; // Calls to the expensive function
+
+// Define the (expensive) function here
+double f(double x) {
+    evaluations++;
+    // Example: damped oscillation with several roots on [0, 20]
+    return cos(x) * exp(-x / 10) - 0.1;
+}
+
+// Proxy used in place of f
+Chebyshev proxy;
+
+double f_proxy(double x) {
+    return chebyshev_eval(&proxy, x);
+}
+
+// Romberg integration function (as in 01-rombergs-integration.c)
+double romberg(double (*func)(double), double a, double b, int n) {
+    double R[n][n];
+    int i, j, k;
+    double h = b - a;
+
+    for (i = 0; i < n; i++) {
+        int N = 1 << i; // 2^i
+        double sum = 0.0;
+        double step = h / N;
+        for (k = 1; k < N; k += 2) {
+            sum += func(a + k * step);
+        }
+        if (i == 0)
+            R[i][0] = (func(a) + func(b)) * h / 2.0;
+        else
+            R[i][0] = 0.5 * R[i-1][0] + sum * step;
+    }
+
+    for (i = 1; i < n; i++) {
+        for (j = 1; j <= i; j++) {
+            R[i][j] = R[i][j-1] + (R[i][j-1] - R[i-1][j-1]) / (pow(4, j) - 1);
+        }
+    }
+
+    return R[n-1][n-1];
+}
+
+// Bisection on [a, b] (f(a) * f(b) < 0)
+double bisection(double (*func)(double), double a, double b) {
+    double fa = func(a), x = a;
+    while (fabs(b - a) > 1e-12) {
+        x = (a + b) / 2.0;
+        double fx = func(x);
+        if (fa * fx < 0) {
+            b = x;
+        } else {
+            a = x;
+            fa = fx;
+        }
+    }
+    return x;
+}
+
+int main() {
+    double a = 0.0, b = 20.0;
+    int levels = 12;
+    double roots[64];
+
+    // Direct approach: Romberg and a bisection scan on f itself
+    evaluations = 0;
+    double direct_integral = romberg(f, a, b, levels);
+    int direct_integral_evals = evaluations;
+
+    evaluations = 0;
+    int direct_count = 0;
+    double step = (b - a) / 200;
+    for (double x = a; x < b && direct_count < 64; x += step) {
+        if (f(x) * f(x + step) < 0) {
+            roots[direct_count++] = bisection(f, x, x + step);
+        }
+    }
+    int direct_root_evals = evaluations;
+
+    // Proxy approach: sample f once
+    evaluations = 0;
+    if (chebyshev_fit(&proxy, f, a, b, TOLERANCE, MAX_DEGREE) < 0) {
+        printf("Memory allocation failed.\n");
+        return 1;
+    }
+    int proxy_evals = evaluations;
+
+    double proxy_romberg = romberg(f_proxy, a, b, levels);
+    double proxy_integral = chebyshev_integral(&proxy);
+    double proxy_roots[64];
+    int proxy_count = chebyshev_roots(&proxy, proxy_roots, 64);
+
+    printf("Chebyshev proxy of f on [%.1f, %.1f]: degree %d from %d evaluations of f\n\n",
+           a, b, proxy.degree, proxy_evals);
+
+    printf("Integration\n");
+    printf("-----------------------------------------------------------------\n");
+    printf("Romberg on f:             %.12lf (%d evaluations of f)\n", direct_integral, direct_integral_evals);
+    printf("Romberg on proxy:         %.12lf (0 further evaluations)\n", proxy_romberg);
+    printf("Clenshaw-Curtis on proxy: %.12lf (0 further evaluations)\n", proxy_integral);
+    printf("-----------------------------------------------------------------\n\n");
+
+    printf("Root finding\n");
+    printf("-----------------------------------------------------------------\n");
+    printf("Bisection scan on f: %d roots (%d evaluations of f)\n", direct_count, direct_root_evals);
+    printf("Colleague matrix on proxy: %d roots (0 further evaluations)\n", proxy_count);
+    for (int i = 0; i < proxy_count; i++) {
+        printf("Root %d: x = %.12lf", i + 1, proxy_roots[i]);
+        if (i < direct_count) {
+            printf("  (bisection: %.12lf)", roots[i]);
+        }
+        printf("\n");
+    }
+    printf("-----------------------------------------------------------------\n");
+
+    chebyshev_free(&proxy);
+
+    return 0;
+}
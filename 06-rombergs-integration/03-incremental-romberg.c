@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <math.h>
+#include "../common/romberg.h"
+#include "../common/expression.h"
+
+// Incremental Romberg integration: two rows of memory, stops on convergence, resumable
+// Compile: gcc -O2 -fopenmp 03-incremental-romberg.c -o incremental-romberg -lm
+// Usage:   ./incremental-romberg ["expression" [a b]]
+
+#define MAX_LEVELS 30
+
+// Expression given on the command line, e.g. "x*exp(x)-cos(x)"
+Expression expression;
+int use_expression = 0;
+
+// Define the function to integrate here
+double f(double x) {
+    // Runtime expression, when one was given
+    if (use_expression)
+        return expr_eval(&expression, x, 0.0);
+
+    // Example: integrate sin(x)
+    return sin(x);
+}
+
+int main(int argc, char const *argv[]) {
+    double a = 0.0, b = M_PI;
+    double tolerances[] = {1e-6, 1e-10, 1e-14};
+    RombergState state;
+
+    // Use the function given as the first argument instead of the built-in one
+    if (argc > 1) {
+        if (expr_compile(&expression, argv[1]) != 0)
+            return 1;
+        use_expression = 1;
+        printf("Function: f(x) = %s\n", argv[1]);
+    }
+    if (argc > 3) {
+        a = atof(argv[2]);
+        b = atof(argv[3]);
+    }
+
+    printf("Integral from %.6lf to %.6lf, refined in place for tighter tolerances\n", a, b);
+    printf("----------------------------------------------------------------------\n");
+    printf("%-10s %-20s %-12s %-7s %s\n", "Tolerance", "Result", "Error est.", "Levels", "Evaluations");
+    printf("----------------------------------------------------------------------\n");
+
+    romberg_init(&state, f, a, b);
+    for (int t = 0; t < 3; t++) {
+        // Resumes from the levels already computed for the previous tolerance
+        int status = romberg_integrate(&state, tolerances[t], tolerances[t], MAX_LEVELS);
+        printf("%-10.0e %-20.14lf %-12.2e %-7d %ld%s\n", tolerances[t], romberg_value(&state), romberg_error(&state),
+               state.level + 1, state.evaluations, status ? " (not converged)" : "");
+    }
+    printf("----------------------------------------------------------------------\n");
+
+    return 0;
+}
@@ -1,8 +1,21 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/expression.h"
+#include "../common/trace.h"
+
+// Expression given on the command line, e.g. "x*y - x^2"
+Expression expression;
+int use_expression = 0;
 
 // Define function
-#define f(x, y) x + y
+float f(float x, float y)
+{
+    // Runtime expression, when one was given
+    if (use_expression)
+        return expr_eval(&expression, x, y);
+
+    return x + y;
+}
 
 // Enum for different methods
 typedef enum
@@ -12,6 +25,12 @@ typedef enum
     RK4
 } Method;
 
+// Print one traced step: x, y, f(x, y)
+void print_step(const TraceRecord *r)
+{
+    printf("%d\t%8.4f\t%10.6f\t%10.6f\n", r->iteration, r->values[0], r->values[1], r->values[2]);
+}
+
 // Runge-Kutta 1st Order Method
 void RK1Meth(float x0, float y0, float h, float xn)
 {
@@ -20,13 +39,16 @@ void RK1Meth(float x0, float y0, float h, float xn)
     printf("Solution using Runge-Kutta 1st Order Method:\n");
     printf("\nStep\t   x\t\t   y\t\tf(x, y)\n");
     printf("---------------------------------------------------\n");
+    trace_begin("rk1");
     while (x < xn) // To include xn if x reaches it
     {
-        printf("%d\t%8.4f\t%10.6f\t%10.6f\n", step, x, y, x + y);
-        y = y + h * (x + y);
+        TRACE(step, x, y, f(x, y));
+        y = y + h * f(x, y);
         x = x + h;
         step++;
     }
+    trace_end();
+    trace_print(print_step);
     printf("---------------------------------------------------\n");
     printf("Approximate value of y at x = %.4f is %.6f\n", xn, y);
 }
@@ -39,15 +61,18 @@ void RK2Meth(float x0, float y0, float h, float xn)
     printf("Solution using Runge-Kutta 2nd Order Method:\n");
     printf("\nStep\t   x\t\t   y\t\tf(x, y)\n");
     printf("---------------------------------------------------\n");
+    trace_begin("rk2");
     while (x < xn) // To include xn if x reaches it
     {
-        printf("%d\t%8.4f\t%10.6f\t%10.6f\n", step, x, y, x + y);
-        float k1 = h * (x + y);
-        float k2 = h * (x + h + (y + k1));
+        TRACE(step, x, y, f(x, y));
+        float k1 = h * f(x, y);
+        float k2 = h * f(x + h, y + k1);
         y = y + 0.5 * (k1 + k2);
         x = x + h;
         step++;
     }
+    trace_end();
+    trace_print(print_step);
     printf("---------------------------------------------------\n");
     printf("Approximate value of y at x = %.4f is %.6f\n", xn, y);
 }
@@ -60,23 +85,36 @@ void RK4Meth(float x0, float y0, float h, float xn)
     printf("Solution using Runge-Kutta 4th Order Method:\n");
     printf("\nStep\t   x\t\t   y\t\tf(x, y)\n");
     printf("---------------------------------------------------\n");
+    trace_begin("rk4");
     while(x < xn) // To include xn if x reaches it
     {
-        float k1 = h * (x + y);
-        float k2 = h * (x + h / 2 + (y + k1 / 2));
-        float k3 = h * (x + h / 2 + (y + k2 / 2));
-        float k4 = h * (x + h + (y + k3));
-        printf("%d\t%8.4f\t%10.6f\t%10.6f\n", step, x, y, x + y);
+        float k1 = h * f(x, y);
+        float k2 = h * f(x + h / 2, y + k1 / 2);
+        float k3 = h * f(x + h / 2, y + k2 / 2);
+        float k4 = h * f(x + h, y + k3);
+        TRACE(step, x, y, f(x, y));
         y = y + (k1 + 2 * k2 + 2 * k3 + k4) / 6;
         x = x + h;
         step++;
     }
+    trace_end();
+    trace_print(print_step);
 }
 
 // Driver code
-int main()
+int main(int argc, char const *argv[])
 {
     float x0 = 0, y0 = 1, h = 0.2, xn;
+
+    // Use the function f(x, y) given as the first argument instead of the built-in one
+    if (argc > 1)
+    {
+        if (expr_compile(&expression, argv[1]) != 0)
+            return 1;
+        use_expression = 1;
+        printf("Function: f(x, y) = %s\n", argv[1]);
+    }
+
     printf("Enter the value of x at which you want to find y: ");
     scanf("%f", &xn);
 
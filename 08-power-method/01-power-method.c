@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include "../common/trace.h"
 
 #define SIZE 10 // Size of the array
 #define TOLERANCE 0.00001 // Tolerance for  comparison of successive iterations
@@ -57,13 +58,24 @@ void normalize(double X[SIZE], size_t size) {
     }
 }
 
+// Print one traced iteration: lambda followed by the normalized vector
+void print_iteration(const TraceRecord *r) {
+    printf("Iteration %d: ", r->iteration + 1);
+    for (int i = 1; i < r->count; i++) {
+        printf("%lf ", r->values[i]);
+    }
+    printf("\t: lambda = %lf", r->values[0]);
+    printf("\n");
+}
+
 // Power method to find the dominant eigenvalue and eigenvector
 void powerMethod(const double A[SIZE][SIZE], double X[SIZE], size_t size  ) {
-    double Y[SIZE];
+    double Y[SIZE], lambda = 0.0;
     int iterations = 0;
 
     printf("***************************************************************************\n");
     printf("Power Method to find the dominant eigenvalue and eigenvector:\n");
+    trace_begin("power-method");
 
     // Iterate until convergence or maximum iterations reached
     while (iterations < MAX_ITERATIONS) {
@@ -71,18 +83,19 @@ void powerMethod(const double A[SIZE][SIZE], double X[SIZE], size_t size  ) {
         matrixVectorMultiply(A, X, Y, size);
 
         // Find the value of lambda (dominant eigenvalue)
-        double lambda = max_absolute_value(Y, size);
+        lambda = max_absolute_value(Y, size);
 
-        // Normalize the resulting vector Y
-        normalize(Y, size);
-
-        // Print the current iteration and the resulting vector in table format
-        printf("Iteration %d: ", iterations + 1);
+        // Record the current iteration: lambda and the normalized vector
+#ifndef TRACE_OFF
+        double row[SIZE + 1] = {lambda};
         for (size_t i = 0; i < size; i++) {
-            printf("%lf ", Y[i]);
+            row[i + 1] = lambda != 0.0 ? Y[i] / lambda : Y[i];
         }
-        printf("\t: lambda = %lf", lambda);
-        printf("\n");
+        TRACE_VECTOR(iterations, row, (int)size + 1);
+#endif
+
+        // Normalize the resulting vector Y
+        normalize(Y, size);
 
         // Check for convergence
         double norm_diff = 0.0f;
@@ -103,9 +116,14 @@ void powerMethod(const double A[SIZE][SIZE], double X[SIZE], size_t size  ) {
         iterations++;
     }
 
+    // Print the iteration table
+    trace_end();
+    trace_print(print_iteration);
+
     printf("***************************************************************************\n");
 
     printf("Converged after %d iterations.\n", iterations);
+    printf("Dominant eigenvalue: %lf\n", lambda);
     printf("Dominant eigenvector:\n");
     for (size_t i = 0; i < size; i++) {
         printf("%lf ", X[i]);
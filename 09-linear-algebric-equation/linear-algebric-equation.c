@@ -9,6 +9,7 @@ x1 + x2 + 3x3 = 3
 
 #include <stdio.h>
 #include <math.h>
+#include "../common/trace.h"
 
 // Maximum number of iterations
 #define MAX_ITR 100
@@ -20,6 +21,12 @@ x1 + x2 + 3x3 = 3
 #define f2(x1, x2, x3) (7 - 3 * x1 - x3) / 5
 #define f3(x1, x2, x3) (3 - x1 - x2) / 3
 
+// Print one traced iteration: x1, x2, x3
+void print_iteration(const TraceRecord *r)
+{
+    printf("%d\t\t %.4f\t %.4f\t %.4f\n", r->iteration + 1, r->values[0], r->values[1], r->values[2]);
+}
+
 // Function to solve using Gauss-Jacobi Method
 void Gauss_jacobi(float x10, float x20, float x30)
 {
@@ -28,6 +35,7 @@ void Gauss_jacobi(float x10, float x20, float x30)
 
     printf("\n--- Gauss-Jacobi Method ---\n");
     printf("Iteration\t x1\t\t x2\t\t x3\n");
+    trace_begin("gauss-jacobi");
 
     // Iterative process
     do
@@ -37,8 +45,8 @@ void Gauss_jacobi(float x10, float x20, float x30)
         x2 = f2(x10, x20, x30);
         x3 = f3(x10, x20, x30);
 
-        // Print current iteration results
-        printf("%d\t\t %.4f\t %.4f\t %.4f\n", itr + 1, x1, x2, x3);
+        // Record current iteration results
+        TRACE(itr, x1, x2, x3);
 
         // Check for convergence
         if (fabs(x1 - x10) < tol && fabs(x2 - x20) < tol && fabs(x3 - x30) < tol)
@@ -50,6 +58,10 @@ void Gauss_jacobi(float x10, float x20, float x30)
         x30 = x3;
         itr++;
     } while (itr < MAX_ITR);
+
+    // Print the iteration table
+    trace_end();
+    trace_print(print_iteration);
 }
 
 // Function to solve using Gauss-Seidel Method
@@ -60,6 +72,7 @@ void Gauss_seidel(float x10, float x20, float x30)
 
     printf("\n--- Gauss-Seidel Method ---\n");
     printf("Iteration\t x1\t\t x2\t\t x3\n");
+    trace_begin("gauss-seidel");
 
     // Iterative process
     do
@@ -69,8 +82,8 @@ void Gauss_seidel(float x10, float x20, float x30)
         x2 = f2(x1, x20, x30);   // Use updated x1
         x3 = f3(x1, x2, x30);    // Use updated x1 and x2
 
-        // Print current iteration results
-        printf("%d\t\t %.4f\t %.4f\t %.4f\n", itr + 1, x1, x2, x3);
+        // Record current iteration results
+        TRACE(itr, x1, x2, x3);
 
         // Check for convergence
         if (fabs(x1 - x10) < tol && fabs(x2 - x20) < tol && fabs(x3 - x30) < tol)
@@ -82,6 +95,10 @@ void Gauss_seidel(float x10, float x20, float x30)
         x30 = x3;
         itr++;
     } while (itr < MAX_ITR);
+
+    // Print the iteration table
+    trace_end();
+    trace_print(print_iteration);
 }
 
 int main()
@@ -0,0 +1,512 @@
+// Chebyshev proxy for expensive functions
+// chebyshev_fit() samples f on Chebyshev-Lobatto points of [a, b], doubling the degree
+// (and reusing every earlier sample) until the coefficients decay below the tolerance.
+// The cheap proxy then replaces f:
+//     chebyshev_eval()      value by Clenshaw recurrence
+//     chebyshev_integral()  integral by Clenshaw-Curtis weights
+//     chebyshev_roots()     real roots from the colleague-matrix eigenvalues (a multiple
+//                           root is reported once)
+//
+// Header only: include it with #include "../common/chebyshev.h" and link with -lm.
+#ifndef CHEBYSHEV_H
+#define CHEBYSHEV_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#define CHEB_MIN_DEGREE 16
+#define CHEB_MAX_ROOT_DEGREE 64 // Larger proxies are split before the eigenvalue solve
+#define CHEB_MAX_SPLITS 16      // Recursion limit for the splitting
+#define CHEB_MAX_QR_STEPS 60    // Francis steps allowed per deflation
+#define CHEB_ROOT_RESIDUAL 1e-13 // |series| / sum |c_k| below which a near-real eigenvalue is a root
+
+// Chebyshev series sum c[k] T_k(t) on [a, b], t = (2x - a - b) / (b - a)
+typedef struct
+{
+    double a, b;
+    int degree;
+    double *c;       // degree + 1 coefficients
+    int evaluations; // Calls to f made while fitting
+} Chebyshev;
+
+// Map x in [a, b] to t in [-1, 1]
+static inline double cheb_to_unit(const Chebyshev *p, double x)
+{
+    return (2.0 * x - p->a - p->b) / (p->b - p->a);
+}
+
+// Coefficients from values at the n + 1 Lobatto points t_j = cos(j pi / n)
+static void cheb_coefficients(const double values[], int n, double c[])
+{
+    for (int k = 0; k <= n; k++)
+    {
+        double sum = 0.5 * (values[0] + (k % 2 ? -values[n] : values[n]));
+        for (int j = 1; j < n; j++)
+            sum += values[j] * cos(M_PI * j * k / n);
+        c[k] = 2.0 * sum / n;
+    }
+    c[0] *= 0.5;
+    c[n] *= 0.5;
+}
+
+// Fit f on [a, b] until the trailing coefficients fall below tol * max|c|.
+// Returns 0 on success, 1 if max_degree was reached first, -1 on allocation failure.
+static inline int chebyshev_fit(Chebyshev *p, double (*f)(double), double a, double b, double tol, int max_degree)
+{
+    int n = CHEB_MIN_DEGREE, status = 1;
+    double *values = malloc((n + 1) * sizeof(double));
+
+    memset(p, 0, sizeof(*p));
+    p->a = a;
+    p->b = b;
+    if (!values)
+        return -1;
+
+    for (int j = 0; j <= n; j++)
+        values[j] = f(0.5 * (a + b) + 0.5 * (b - a) * cos(M_PI * j / n));
+    p->evaluations = n + 1;
+
+    while (1)
+    {
+        double *c = realloc(p->c, (n + 1) * sizeof(double));
+        if (!c)
+        {
+            free(values);
+            return -1;
+        }
+        p->c = c;
+        cheb_coefficients(values, n, c);
+
+        double scale = 0.0;
+        for (int k = 0; k <= n; k++)
+            scale = fmax(scale, fabs(c[k]));
+        double tail = fmax(fabs(c[n]), fmax(fabs(c[n - 1]), fabs(c[n - 2])));
+
+        if (tail <= tol * scale || scale == 0.0)
+        {
+            status = 0;
+            break;
+        }
+        if (2 * n > max_degree)
+            break;
+
+        // Double the degree: old points are the even-indexed new points
+        double *grown = realloc(values, (2 * n + 1) * sizeof(double));
+        if (!grown)
+        {
+            free(values);
+            return -1;
+        }
+        values = grown;
+        for (int j = n; j >= 0; j--)
+            values[2 * j] = values[j];
+        for (int j = 1; j < 2 * n; j += 2)
+            values[j] = f(0.5 * (a + b) + 0.5 * (b - a) * cos(M_PI * j / (2 * n)));
+        p->evaluations += n;
+        n *= 2;
+    }
+
+    // Chop the negligible tail
+    double scale = 0.0;
+    for (int k = 0; k <= n; k++)
+        scale = fmax(scale, fabs(p->c[k]));
+    p->degree = n;
+    while (p->degree > 0 && fabs(p->c[p->degree]) <= tol * scale)
+        p->degree--;
+
+    free(values);
+    return status;
+}
+
+static inline void chebyshev_free(Chebyshev *p)
+{
+    free(p->c);
+    p->c = NULL;
+    p->degree = 0;
+}
+
+// Evaluate the proxy at x with the Clenshaw recurrence
+static inline double chebyshev_eval(const Chebyshev *p, double x)
+{
+    double t = cheb_to_unit(p, x), b1 = 0.0, b2 = 0.0;
+
+    for (int k = p->degree; k >= 1; k--)
+    {
+        double b0 = 2.0 * t * b1 - b2 + p->c[k];
+        b2 = b1;
+        b1 = b0;
+    }
+    return t * b1 - b2 + p->c[0];
+}
+
+// Integral of the proxy over [a, b] (Clenshaw-Curtis)
+static inline double chebyshev_integral(const Chebyshev *p)
+{
+    double sum = 0.0;
+    for (int k = 0; k <= p->degree; k += 2)
+        sum += p->c[k] * 2.0 / (1.0 - (double)k * k);
+    return 0.5 * (p->b - p->a) * sum;
+}
+
+// Apply the reflector I - beta v v^T, v of length len acting on indices k .. k + len - 1,
+// from the left to columns first .. last and from the right to rows top .. bottom
+static void cheb_reflect(double *a, int n, int k, int len, const double v[], double beta, int first, int last,
+                         int top, int bottom)
+{
+    for (int j = first; j <= last; j++)
+    {
+        double dot = 0.0;
+        for (int i = 0; i < len; i++)
+            dot += v[i] * a[(k + i) * n + j];
+        for (int i = 0; i < len; i++)
+            a[(k + i) * n + j] -= beta * dot * v[i];
+    }
+    for (int i = top; i <= bottom; i++)
+    {
+        double dot = 0.0;
+        for (int j = 0; j < len; j++)
+            dot += a[i * n + k + j] * v[j];
+        for (int j = 0; j < len; j++)
+            a[i * n + k + j] -= beta * dot * v[j];
+    }
+}
+
+// Householder vector v (overwriting x, length len) with (I - beta v v^T) x = -+|x| e_1; returns beta
+static double cheb_householder(double v[], int len)
+{
+    double squares = 0.0;
+    for (int i = 0; i < len; i++)
+        squares += v[i] * v[i];
+    if (squares == 0.0)
+        return 0.0;
+
+    // v^T v = 2 (|x|^2 + |x_0| |x|) after the first entry moves away from zero
+    double norm = sqrt(squares), beta = 1.0 / (squares + fabs(v[0]) * norm);
+    v[0] += copysign(norm, v[0]);
+    return beta;
+}
+
+// One Francis double-shift QR step on the unreduced block lo .. hi (at least 3 x 3) of the
+// upper Hessenberg matrix a, with shifts the roots of mu^2 - sum mu + product: a 3 x 3
+// reflector starts a bulge at the top of the block and chases it down the subdiagonal
+// (Golub and Van Loan, Matrix Computations, Algorithm 7.5.1)
+static void cheb_francis_step(double *a, int n, int lo, int hi, double sum, double product)
+{
+#define H(i, j) a[(i) * n + (j)]
+    // First column of (A - mu_1 I)(A - mu_2 I), nonzero in its first three rows only
+    double v[3] = {H(lo, lo) * H(lo, lo) + H(lo, lo + 1) * H(lo + 1, lo) - sum * H(lo, lo) + product,
+                   H(lo + 1, lo) * (H(lo, lo) + H(lo + 1, lo + 1) - sum), H(lo + 1, lo) * H(lo + 2, lo + 1)};
+
+    for (int k = lo; k <= hi - 2; k++)
+    {
+        double beta = cheb_householder(v, 3);
+        int first = k > lo ? k - 1 : lo, bottom = k + 3 < hi ? k + 3 : hi;
+        cheb_reflect(a, n, k, 3, v, beta, first, hi, lo, bottom);
+        if (k > lo)
+            H(k + 1, k - 1) = H(k + 2, k - 1) = 0.0;
+
+        v[0] = H(k + 1, k);
+        v[1] = H(k + 2, k);
+        v[2] = k + 3 <= hi ? H(k + 3, k) : 0.0;
+    }
+
+    // The last reflector is 2 x 2
+    double beta = cheb_householder(v, 2);
+    cheb_reflect(a, n, hi - 1, 2, v, beta, hi - 2, hi, lo, hi);
+    H(hi, hi - 2) = 0.0;
+#undef H
+}
+
+// Eigenvalues of an upper Hessenberg matrix a (n x n, row major, destroyed) by Francis
+// double-shift QR steps, deflating 1 x 1 and 2 x 2 blocks off the bottom as their subdiagonal
+// entries become negligible. Returns 0 on success, -1 if an eigenvalue did not converge.
+static int cheb_hessenberg_eigenvalues(double *a, int n, double wr[], double wi[])
+{
+#define H(i, j) a[(i) * n + (j)]
+    double scale = 0.0;
+    for (int i = 0; i < n; i++)
+        for (int j = i > 0 ? i - 1 : 0; j < n; j++)
+            scale = fmax(scale, fabs(H(i, j)));
+
+    int hi = n - 1, steps = 0;
+    while (hi >= 0)
+    {
+        // Bottom of the lowest unreduced block: the first negligible subdiagonal entry above hi
+        int lo = hi;
+        while (lo > 0)
+        {
+            double local = fabs(H(lo - 1, lo - 1)) + fabs(H(lo, lo));
+            if (fabs(H(lo, lo - 1)) <= DBL_EPSILON * (local > 0.0 ? local : scale))
+            {
+                H(lo, lo - 1) = 0.0;
+                break;
+            }
+            lo--;
+        }
+
+        if (lo == hi)
+        {
+            wr[hi] = H(hi, hi);
+            wi[hi] = 0.0;
+            hi--;
+            steps = 0;
+        }
+        else if (lo == hi - 1)
+        {
+            // Eigenvalues d + p +- sqrt(p^2 + bc) of [a b; c d], p = (a - d) / 2, without cancellation
+            double b = H(hi - 1, hi), c = H(hi, hi - 1), d = H(hi, hi);
+            double p = 0.5 * (H(hi - 1, hi - 1) - d), discriminant = p * p + b * c;
+            if (discriminant >= 0.0)
+            {
+                double root = p + copysign(sqrt(discriminant), p);
+                wr[hi - 1] = d + root;
+                wr[hi] = root != 0.0 ? d - b * c / root : d;
+                wi[hi - 1] = wi[hi] = 0.0;
+            }
+            else
+            {
+                wr[hi - 1] = wr[hi] = d + p;
+                wi[hi - 1] = sqrt(-discriminant);
+                wi[hi] = -wi[hi - 1];
+            }
+            hi -= 2;
+            steps = 0;
+        }
+        else
+        {
+            if (++steps > CHEB_MAX_QR_STEPS)
+                return -1;
+
+            // Shifts: the eigenvalues of the trailing 2 x 2 block, or, every tenth step without
+            // a deflation, a double real shift moved off the diagonal to break a cycle
+            double sum, product;
+            if (steps % 10 == 0)
+            {
+                double mu = H(hi, hi) + fabs(H(hi, hi - 1)) + fabs(H(hi - 1, hi - 2));
+                sum = 2.0 * mu;
+                product = mu * mu;
+            }
+            else
+            {
+                sum = H(hi - 1, hi - 1) + H(hi, hi);
+                product = H(hi - 1, hi - 1) * H(hi, hi) - H(hi - 1, hi) * H(hi, hi - 1);
+            }
+            cheb_francis_step(a, n, lo, hi, sum, product);
+        }
+    }
+    return 0;
+#undef H
+}
+
+// Balance a matrix (row major, n x n) to improve the accuracy of its eigenvalues: a diagonal
+// similarity by powers of two (exact in floating point) brings the off-diagonal norms of each
+// row and its column close together (Parlett and Reinsch, as in LAPACK dgebal without permutations)
+static void cheb_balance(double *a, int n)
+{
+    for (int sweep = 0, changed = 1; changed && sweep < 100; sweep++)
+    {
+        changed = 0;
+        for (int i = 0; i < n; i++)
+        {
+            double row = 0.0, column = 0.0;
+            for (int j = 0; j < n; j++)
+            {
+                if (j == i)
+                    continue;
+                row += fabs(a[i * n + j]);
+                column += fabs(a[j * n + i]);
+            }
+            if (row == 0.0 || column == 0.0)
+                continue;
+
+            // Scaling row i by 1/f and column i by f turns row + column into row / f + column f,
+            // smallest near f = sqrt(row / column); take the nearest power of two
+            int exponent;
+            frexp(row / column, &exponent);
+            double f = ldexp(1.0, exponent / 2);
+            if (f == 1.0 || row / f + column * f >= 0.95 * (row + column))
+                continue;
+
+            changed = 1;
+            for (int j = 0; j < n; j++)
+                a[i * n + j] /= f;
+            for (int j = 0; j < n; j++)
+                a[j * n + i] *= f;
+        }
+    }
+}
+
+// Newton polish of a root t in [-1, 1] on the series c of the given degree
+static double cheb_polish(const double c[], int degree, double t)
+{
+    for (int it = 0; it < 3; it++)
+    {
+        // Clenshaw for the value and the derivative together
+        double b1 = 0.0, b2 = 0.0, d1 = 0.0, d2 = 0.0;
+        for (int k = degree; k >= 1; k--)
+        {
+            double d0 = 2.0 * b1 + 2.0 * t * d1 - d2;
+            double b0 = 2.0 * t * b1 - b2 + c[k];
+            d2 = d1;
+            d1 = d0;
+            b2 = b1;
+            b1 = b0;
+        }
+        double value = t * b1 - b2 + c[0];
+        double slope = b1 + t * d1 - d2;
+        if (slope == 0.0)
+            break;
+        double step = value / slope;
+        if (fabs(step) > 1e-3)
+            break; // Not in the quadratic basin; keep the eigenvalue
+        t -= step;
+    }
+    return t;
+}
+
+// Real roots of the series c (degree n) on [-1, 1], mapped to [a, b]; appends to roots[]
+static int cheb_roots_unit(const double c[], int n, double a, double b, double roots[], int count, int max_roots,
+                           int depth)
+{
+    // Strip leading zeros
+    while (n > 0 && c[n] == 0.0)
+        n--;
+    if (n <= 0)
+        return count;
+
+    if (n > CHEB_MAX_ROOT_DEGREE && depth < CHEB_MAX_SPLITS)
+    {
+        // Split: resample the (cheap) series on each half at the same degree, then drop
+        // the coefficients that have decayed to rounding level (about half of them)
+        int m = n;
+        double *values = malloc((size_t)(m + 1) * sizeof(double));
+        double *half = malloc((size_t)(m + 1) * sizeof(double));
+        double mid = -0.004849834917525; // Slightly off-centre so roots rarely land on the split
+        double ends[3] = {-1.0, mid, 1.0};
+        if (!values || !half)
+        {
+            free(values);
+            free(half);
+            return count;
+        }
+        for (int side = 0; side < 2; side++)
+        {
+            double lo = ends[side], hi = ends[side + 1];
+            Chebyshev series = {-1.0, 1.0, n, (double *)c, 0};
+            for (int j = 0; j <= m; j++)
+                values[j] = chebyshev_eval(&series, 0.5 * (lo + hi) + 0.5 * (hi - lo) * cos(M_PI * j / m));
+            cheb_coefficients(values, m, half);
+
+            double scale = 0.0;
+            int degree = m;
+            for (int k = 0; k <= m; k++)
+                scale = fmax(scale, fabs(half[k]));
+            while (degree > 0 && fabs(half[degree]) <= 1e-13 * scale)
+                degree--;
+
+            count = cheb_roots_unit(half, degree, a + 0.5 * (b - a) * (lo + 1.0), a + 0.5 * (b - a) * (hi + 1.0),
+                                    roots, count, max_roots, depth + 1);
+        }
+        free(values);
+        free(half);
+        return count;
+    }
+
+    // Colleague matrix (transposed so that it is upper Hessenberg)
+    double *m = calloc((size_t)n * n, sizeof(double));
+    double *wr = malloc((size_t)n * sizeof(double));
+    double *wi = malloc((size_t)n * sizeof(double));
+    if (!m || !wr || !wi)
+    {
+        free(m);
+        free(wr);
+        free(wi);
+        return count;
+    }
+    if (n == 1)
+        m[0] = -c[0] / c[1];
+    else
+    {
+        m[1 * n + 0] = 1.0;
+        for (int k = 1; k < n - 1; k++)
+        {
+            m[(k - 1) * n + k] = 0.5;
+            m[(k + 1) * n + k] = 0.5;
+        }
+        m[(n - 2) * n + (n - 1)] = 0.5;
+        for (int j = 0; j < n; j++)
+            m[j * n + (n - 1)] -= c[j] / (2.0 * c[n]);
+    }
+
+    cheb_balance(m, n);
+    if (cheb_hessenberg_eigenvalues(m, n, wr, wi) == 0)
+    {
+        // A root of multiplicity k comes out as eigenvalues about eps^(1/k) apart, often as a
+        // complex pair, so an eigenvalue also counts as real when the series nearly vanishes
+        // at its real part; each conjugate pair gives one root
+        Chebyshev series = {-1.0, 1.0, n, (double *)c, 0};
+        double size = 0.0;
+        for (int k = 0; k <= n; k++)
+            size += fabs(c[k]);
+        for (int i = 0; i < n && count < max_roots; i++)
+        {
+            if (wi[i] < 0.0 || fabs(wr[i]) > 1.0 + 1e-10)
+                continue;
+            double t = fmax(-1.0, fmin(1.0, wr[i]));
+            if (wi[i] <= sqrt(DBL_EPSILON) * (1.0 + fabs(wr[i])) ||
+                fabs(chebyshev_eval(&series, t)) <= CHEB_ROOT_RESIDUAL * size)
+            {
+                t = cheb_polish(c, n, t);
+                roots[count++] = a + 0.5 * (b - a) * (t + 1.0);
+            }
+        }
+    }
+
+    free(m);
+    free(wr);
+    free(wi);
+    return count;
+}
+
+static int cheb_compare(const void *p, const void *q)
+{
+    double x = *(const double *)p, y = *(const double *)q;
+    return (x > y) - (x < y);
+}
+
+// Real roots of the proxy in [a, b], sorted; returns the number stored in roots[]
+static inline int chebyshev_roots(const Chebyshev *p, double roots[], int max_roots)
+{
+    int count = cheb_roots_unit(p->c, p->degree, p->a, p->b, roots, 0, max_roots, 0);
+    qsort(roots, count, sizeof(double), cheb_compare);
+
+    // Merge duplicates from the split points and the clusters a multiple root leaves: neighbours
+    // closer than the tolerance, or with the proxy at rounding level between them, become
+    // the mean of their group
+    double size = 0.0, eps = 1e-10 * (p->b - p->a);
+    for (int k = 0; k <= p->degree; k++)
+        size += fabs(p->c[k]);
+
+    int unique = 0, members = 0;
+    for (int i = 0; i < count; i++)
+    {
+        double last = unique > 0 ? roots[unique - 1] : 0.0;
+        if (unique > 0 && (roots[i] - last <= eps ||
+                           fabs(chebyshev_eval(p, 0.5 * (last + roots[i]))) <= CHEB_ROOT_RESIDUAL * size))
+        {
+            roots[unique - 1] = (last * members + roots[i]) / (members + 1);
+            members++;
+        }
+        else
+        {
+            roots[unique++] = roots[i];
+            members = 1;
+        }
+    }
+    return unique;
+}
+
+#endif // CHEBYSHEV_H
@@ -0,0 +1,139 @@
+// Block reader for CSV files of "x,y" pairs
+// csv_read_pairs() reads the file in blocks of CSV_BLOCK bytes and hands the pairs of each
+// block, interleaved as x0 y0 x1 y1 ..., to a consumer. While one thread parses a block the
+// other reads the next one (double buffering); the consumer then runs outside that region,
+// so a consumer with its own omp parallel loop gets every thread. Lines that do not start
+// with a number, such as a header, are skipped. A line may span two blocks, but no line may
+// be longer than a block.
+//
+// Header only: include it with #include "../common/csv_pairs.h" and compile with -fopenmp
+// for the background reads.
+#ifndef CSV_PAIRS_H
+#define CSV_PAIRS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_BLOCK (8 << 20) // Bytes read per block
+
+// Receives m interleaved pairs; context is passed through from csv_read_pairs()
+typedef void (*csv_pairs_consumer)(void *context, const double *xy, long m);
+
+// Parse the "x,y" lines of text into xy; returns the number of pairs
+static long csv_parse_lines(char *text, double *xy)
+{
+    long m = 0;
+    char *p = text;
+
+    while (*p)
+    {
+        char *end;
+        double x = strtod(p, &end);
+        if (end != p && *end == ',')
+        {
+            char *q = end + 1;
+            double y = strtod(q, &end);
+            if (end != q)
+            {
+                xy[2 * m] = x;
+                xy[2 * m + 1] = y;
+                m++;
+            }
+        }
+        p = strchr(end, '\n');
+        if (!p)
+            break;
+        p++;
+    }
+    return m;
+}
+
+// Pass every pair of the CSV file at path to consume, one block at a time; returns 0, or
+// -1 if the file cannot be read or has a line longer than CSV_BLOCK bytes
+static inline int csv_read_pairs(const char *path, csv_pairs_consumer consume, void *context)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        printf("Error: cannot open %s.\n", path);
+        return -1;
+    }
+
+    // Two blocks (one being read, one being parsed), plus room for a line carried over
+    char *buffer[2] = {malloc(CSV_BLOCK), malloc(CSV_BLOCK)};
+    char *text = malloc(2 * CSV_BLOCK + 1);
+    double *xy = malloc((CSV_BLOCK + 1) * sizeof(double)); // A line is at least 4 bytes: "x,y\n"
+    if (!buffer[0] || !buffer[1] || !text || !xy)
+    {
+        printf("Memory allocation failed.\n");
+        free(buffer[0]);
+        free(buffer[1]);
+        free(text);
+        free(xy);
+        fclose(file);
+        return -1;
+    }
+
+    size_t length = fread(buffer[0], 1, CSV_BLOCK, file), carried = 0;
+    int current = 0, status = 0;
+
+    while (length > 0)
+    {
+        size_t next_length = 0, total = carried + length, complete = total;
+        long m = 0;
+
+        // Read the next block while the complete lines of this one are parsed
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2)
+#endif
+        {
+#ifdef _OPENMP
+#pragma omp section
+#endif
+            next_length = fread(buffer[1 - current], 1, CSV_BLOCK, file);
+#ifdef _OPENMP
+#pragma omp section
+#endif
+            {
+                memcpy(text + carried, buffer[current], length);
+                while (complete > 0 && text[complete - 1] != '\n')
+                    complete--;
+                char saved = text[complete];
+                text[complete] = '\0';
+                m = csv_parse_lines(text, xy);
+                text[complete] = saved;
+            }
+        }
+
+        // At the end of the file the last line may lack its newline
+        if (next_length == 0 && complete < total)
+        {
+            text[total] = '\0';
+            m += csv_parse_lines(text + complete, xy + 2 * m);
+            complete = total;
+        }
+        consume(context, xy, m);
+
+        // A partial line longer than a block would overflow text on the next copy
+        carried = total - complete;
+        if (carried > CSV_BLOCK)
+        {
+            printf("Error: %s has a line longer than %d bytes (or no newlines).\n", path, CSV_BLOCK);
+            status = -1;
+            break;
+        }
+        memmove(text, text + complete, carried);
+        length = next_length;
+        current = 1 - current;
+    }
+
+    free(buffer[0]);
+    free(buffer[1]);
+    free(text);
+    free(xy);
+    fclose(file);
+    return status;
+}
+
+#endif
@@ -0,0 +1,253 @@
+// Double-exponential quadrature
+// A change of variables x = g(t) makes the integrand decay double-exponentially in t, after
+// which the plain trapezoidal rule in t converges very fast, even with endpoint singularities:
+//     tanh_sinh()  [a, b]        x = tanh(pi/2 sinh t)
+//     exp_sinh()   [a, inf)      x = a + exp(pi/2 sinh t)
+//     sinh_sinh()  (-inf, inf)   x = sinh(pi/2 sinh t)
+// Level 0 uses step h = 1; each further level halves h and only evaluates the new (odd)
+// nodes, so I_l = I_(l-1) / 2 + h * (sum over the new nodes) reuses every earlier evaluation.
+// The nodes and weights of all levels are tabulated once on first use. The tanh-sinh table
+// stores the distance of each node from the nearest endpoint, so points within 1e-300 of a
+// singular endpoint at 0 are still resolved. Elsewhere a node closer to an endpoint than
+// one ulp of it rounds onto the endpoint: it is evaluated there when f is finite at the
+// endpoint and dropped when it is not. Refinement stops when two levels agree to
+// max(abs_tol, rel_tol * |I|); tanh_sinh() accepts a > b and returns the negated integral.
+//
+// Header only: include it with #include "../common/double_exponential.h" and link with -lm.
+#ifndef DOUBLE_EXPONENTIAL_H
+#define DOUBLE_EXPONENTIAL_H
+
+#include <stdlib.h>
+#include <math.h>
+#include "integration.h"
+
+#define DE_MAX_LEVEL 8
+
+typedef enum
+{
+    TANH_SINH = 0,
+    EXP_SINH,
+    SINH_SINH
+} DEKind;
+
+// A node of the transformed trapezoidal rule
+typedef struct
+{
+    double x; // tanh-sinh: distance from the endpoint; exp-sinh: x - a; sinh-sinh: |x|
+    double w; // dx/dt
+} DENode;
+
+// Nodes of every level; level l occupies nodes[start[l]] to nodes[start[l + 1] - 1]
+typedef struct
+{
+    int start[DE_MAX_LEVEL + 2];
+    DENode *nodes;
+} DETable;
+
+// Range of t for each kind. tanh-sinh and sinh-sinh are symmetric and only t >= 0 is
+// stored (t = 0 is the centre); exp-sinh stores both signs.
+static const double de_t_min[3] = {0.0, -5.0, 0.0};
+static const double de_t_max[3] = {6.0, 4.5, 4.0};
+
+static DETable de_tables[3];
+
+// Node and weight at t
+static DENode de_node(DEKind kind, double t)
+{
+    double u = M_PI_2 * sinh(t), du = M_PI_2 * cosh(t);
+
+    if (kind == TANH_SINH)
+    {
+        // 1 - tanh(u) = exp(-u) / cosh(u), without cancellation
+        double c = cosh(u);
+        return (DENode){exp(-u) / c, du / (c * c)};
+    }
+    if (kind == EXP_SINH)
+        return (DENode){exp(u), du * exp(u)};
+    return (DENode){sinh(u), du * cosh(u)};
+}
+
+// Tabulate the nodes of one kind; returns 0 or -1 on allocation failure
+static int de_build(DEKind kind, DETable *table)
+{
+    double lo = de_t_min[kind], hi = de_t_max[kind];
+    int count = 0;
+
+    // Level 0: integers in [lo, hi]; level l: odd multiples of 2^-l
+    for (int l = 0; l <= DE_MAX_LEVEL; l++)
+    {
+        double h = ldexp(1.0, -l);
+        int k_lo = (int)ceil(lo / h), k_hi = (int)floor(hi / h);
+        table->start[l] = count;
+        for (int k = k_lo; k <= k_hi; k++)
+            count += l == 0 || k % 2 != 0;
+    }
+    table->start[DE_MAX_LEVEL + 1] = count;
+
+    table->nodes = malloc(count * sizeof(DENode));
+    if (!table->nodes)
+        return -1;
+
+    count = 0;
+    for (int l = 0; l <= DE_MAX_LEVEL; l++)
+    {
+        double h = ldexp(1.0, -l);
+        int k_lo = (int)ceil(lo / h), k_hi = (int)floor(hi / h);
+        for (int k = k_lo; k <= k_hi; k++)
+        {
+            if (l == 0 || k % 2 != 0)
+                table->nodes[count++] = de_node(kind, k * h);
+        }
+    }
+    return 0;
+}
+
+// Table of one kind, built on first use; NULL on allocation failure
+static const DETable *de_table(DEKind kind)
+{
+    DETable *table = &de_tables[kind];
+    int failed = 0;
+
+#ifdef _OPENMP
+#pragma omp critical(de_tables)
+#endif
+    {
+        if (!table->nodes)
+            failed = de_build(kind, table) != 0;
+    }
+    return failed ? NULL : table;
+}
+
+// Release the tables
+static inline void de_free_tables(void)
+{
+    for (int kind = 0; kind < 3; kind++)
+    {
+        free(de_tables[kind].nodes);
+        de_tables[kind].nodes = NULL;
+    }
+}
+
+// f at a tanh-sinh node x of [a, b]. A node that rounds onto an endpoint takes the value of
+// f there, computed once per level in *fa or *fb (NAN until then); it counts as 0 when f is
+// not finite at the endpoint, as at a singularity.
+static double de_inner_value(double (*f)(double), double x, double a, double b, double *fa, double *fb,
+                             long *evaluations)
+{
+    if (x > a && x < b)
+    {
+        (*evaluations)++;
+        return f(x);
+    }
+
+    double *endpoint = x <= a ? fa : fb;
+    if (isnan(*endpoint))
+    {
+        *endpoint = f(x <= a ? a : b);
+        (*evaluations)++;
+        if (!isfinite(*endpoint))
+            *endpoint = 0.0;
+    }
+    return *endpoint;
+}
+
+// Sum of w f(x) over the nodes of one level. For tanh-sinh, [a, b] (a < b) is given by its
+// centre and half width.
+static double de_level_sum(DEKind kind, const DETable *table, int level, double (*f)(double), double a, double b,
+                           long *evaluations)
+{
+    double center = 0.5 * (a + b), half = 0.5 * (b - a), sum = 0.0, fa = NAN, fb = NAN;
+
+    for (int i = table->start[level]; i < table->start[level + 1]; i++)
+    {
+        DENode node = table->nodes[i];
+
+        if (kind == TANH_SINH)
+        {
+            if (node.x == 1.0) // t = 0
+            {
+                sum += node.w * f(center);
+                (*evaluations)++;
+                continue;
+            }
+            sum += node.w * de_inner_value(f, a + half * node.x, a, b, &fa, &fb, evaluations);
+            sum += node.w * de_inner_value(f, b - half * node.x, a, b, &fa, &fb, evaluations);
+        }
+        else if (kind == EXP_SINH)
+        {
+            double x = a + node.x;
+            if (x > a && isfinite(x))
+            {
+                sum += node.w * f(x);
+                (*evaluations)++;
+            }
+        }
+        else
+        {
+            sum += node.w * f(node.x);
+            (*evaluations)++;
+            if (node.x != 0.0)
+            {
+                sum += node.w * f(-node.x);
+                (*evaluations)++;
+            }
+        }
+    }
+    return sum;
+}
+
+// Refine level by level. Returns 0 when converged, 1 if DE_MAX_LEVEL was reached and
+// -1 on allocation failure.
+static int de_integrate(DEKind kind, double (*f)(double), double a, double b, double abs_tol, double rel_tol,
+                        QuadratureResult *result)
+{
+    const DETable *table = de_table(kind);
+    if (!table)
+        return -1;
+
+    double h = 1.0;
+    result->evaluations = 0;
+    result->value = de_level_sum(kind, table, 0, f, a, b, &result->evaluations) * (kind == TANH_SINH ? 0.5 * (b - a) : 1.0);
+    result->error = INFINITY;
+
+    for (int level = 1; level <= DE_MAX_LEVEL; level++)
+    {
+        h *= 0.5;
+        double previous = result->value;
+        double sum = de_level_sum(kind, table, level, f, a, b, &result->evaluations);
+        result->value = 0.5 * previous + h * sum * (kind == TANH_SINH ? 0.5 * (b - a) : 1.0);
+        result->error = fabs(result->value - previous);
+        result->intervals = level;
+
+        if (level >= 3 && result->error <= fmax(abs_tol, rel_tol * fabs(result->value)))
+            return 0;
+    }
+    return 1;
+}
+
+// Integral of f over the finite interval [a, b]; f may be singular at a and b
+static inline int tanh_sinh(double (*f)(double), double a, double b, double abs_tol, double rel_tol,
+                            QuadratureResult *result)
+{
+    if (a > b)
+    {
+        int status = de_integrate(TANH_SINH, f, b, a, abs_tol, rel_tol, result);
+        result->value = -result->value;
+        return status;
+    }
+    return de_integrate(TANH_SINH, f, a, b, abs_tol, rel_tol, result);
+}
+
+// Integral of f over [a, inf)
+static inline int exp_sinh(double (*f)(double), double a, double abs_tol, double rel_tol, QuadratureResult *result)
+{
+    return de_integrate(EXP_SINH, f, a, INFINITY, abs_tol, rel_tol, result);
+}
+
+// Integral of f over (-inf, inf)
+static inline int sinh_sinh(double (*f)(double), double abs_tol, double rel_tol, QuadratureResult *result)
+{
+    return de_integrate(SINH_SINH, f, -INFINITY, INFINITY, abs_tol, rel_tol, result);
+}
+
+#endif
@@ -0,0 +1,147 @@
+// Forward-mode automatic differentiation
+// A Dual number carries a value and its first derivative, so writing f once in terms of
+// the dual_* functions gives f(x) and f'(x) from a single evaluation pass.
+// A HyperDual number also carries the second derivative (f, f', f'').
+//
+// Header only: include it with #include "../common/dual.h" and link with -lm.
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <math.h>
+
+// Value and first derivative
+typedef struct
+{
+    double val; // f(x)
+    double der; // f'(x)
+} Dual;
+
+// Value, first and second derivative
+typedef struct
+{
+    double val; // f(x)
+    double d1;  // f'(x)
+    double d2;  // f''(x)
+} HyperDual;
+
+// ---------------------------------------------------------------------------
+// Dual numbers
+// ---------------------------------------------------------------------------
+
+// The independent variable x (derivative 1)
+static inline Dual dual_var(double x) { return (Dual){x, 1.0}; }
+
+// A constant c (derivative 0)
+static inline Dual dual_const(double c) { return (Dual){c, 0.0}; }
+
+static inline Dual dual_add(Dual a, Dual b) { return (Dual){a.val + b.val, a.der + b.der}; }
+static inline Dual dual_sub(Dual a, Dual b) { return (Dual){a.val - b.val, a.der - b.der}; }
+static inline Dual dual_neg(Dual a) { return (Dual){-a.val, -a.der}; }
+static inline Dual dual_add_c(Dual a, double c) { return (Dual){a.val + c, a.der}; }
+static inline Dual dual_scale(Dual a, double c) { return (Dual){a.val * c, a.der * c}; }
+
+static inline Dual dual_mul(Dual a, Dual b)
+{
+    return (Dual){a.val * b.val, a.der * b.val + a.val * b.der};
+}
+
+static inline Dual dual_div(Dual a, Dual b)
+{
+    double inv = 1.0 / b.val;
+    return (Dual){a.val * inv, (a.der - a.val * inv * b.der) * inv};
+}
+
+// a^n for a real exponent n; the lower power only enters the derivative, which is
+// skipped when its coefficient is zero so that a = 0 gives no 0 * inf
+static inline Dual dual_pow(Dual a, double n)
+{
+    double g1 = n != 0.0 ? n * pow(a.val, n - 1) : 0.0;
+    return (Dual){pow(a.val, n), g1 * a.der};
+}
+
+static inline Dual dual_sqrt(Dual a)
+{
+    double s = sqrt(a.val);
+    return (Dual){s, 0.5 * a.der / s};
+}
+
+static inline Dual dual_exp(Dual a)
+{
+    double e = exp(a.val);
+    return (Dual){e, e * a.der};
+}
+
+static inline Dual dual_log(Dual a) { return (Dual){log(a.val), a.der / a.val}; }
+static inline Dual dual_log10(Dual a) { return (Dual){log10(a.val), a.der / (a.val * M_LN10)}; }
+static inline Dual dual_sin(Dual a) { return (Dual){sin(a.val), cos(a.val) * a.der}; }
+static inline Dual dual_cos(Dual a) { return (Dual){cos(a.val), -sin(a.val) * a.der}; }
+
+// ---------------------------------------------------------------------------
+// Hyper-dual numbers (second derivative)
+// ---------------------------------------------------------------------------
+
+static inline HyperDual hyper_var(double x) { return (HyperDual){x, 1.0, 0.0}; }
+static inline HyperDual hyper_const(double c) { return (HyperDual){c, 0.0, 0.0}; }
+
+static inline HyperDual hyper_add(HyperDual a, HyperDual b)
+{
+    return (HyperDual){a.val + b.val, a.d1 + b.d1, a.d2 + b.d2};
+}
+
+static inline HyperDual hyper_sub(HyperDual a, HyperDual b)
+{
+    return (HyperDual){a.val - b.val, a.d1 - b.d1, a.d2 - b.d2};
+}
+
+static inline HyperDual hyper_add_c(HyperDual a, double c) { return (HyperDual){a.val + c, a.d1, a.d2}; }
+static inline HyperDual hyper_scale(HyperDual a, double c) { return (HyperDual){a.val * c, a.d1 * c, a.d2 * c}; }
+
+static inline HyperDual hyper_mul(HyperDual a, HyperDual b)
+{
+    return (HyperDual){a.val * b.val, a.d1 * b.val + a.val * b.d1, a.d2 * b.val + 2 * a.d1 * b.d1 + a.val * b.d2};
+}
+
+// Apply a scalar function g with g(v), g'(v), g''(v) given (chain rule)
+static inline HyperDual hyper_chain(HyperDual a, double g, double g1, double g2)
+{
+    return (HyperDual){g, g1 * a.d1, g2 * a.d1 * a.d1 + g1 * a.d2};
+}
+
+static inline HyperDual hyper_div(HyperDual a, HyperDual b)
+{
+    double inv = 1.0 / b.val;
+    return hyper_mul(a, hyper_chain(b, inv, -inv * inv, 2 * inv * inv * inv));
+}
+
+// a^n for a real exponent n, with the derivatives written as for dual_pow()
+static inline HyperDual hyper_pow(HyperDual a, double n)
+{
+    double g1 = n != 0.0 ? n * pow(a.val, n - 1) : 0.0;
+    double g2 = n != 0.0 && n != 1.0 ? n * (n - 1) * pow(a.val, n - 2) : 0.0;
+    return hyper_chain(a, pow(a.val, n), g1, g2);
+}
+
+static inline HyperDual hyper_exp(HyperDual a)
+{
+    double e = exp(a.val);
+    return hyper_chain(a, e, e, e);
+}
+
+static inline HyperDual hyper_log(HyperDual a)
+{
+    return hyper_chain(a, log(a.val), 1.0 / a.val, -1.0 / (a.val * a.val));
+}
+
+static inline HyperDual hyper_sin(HyperDual a)
+{
+    double s = sin(a.val), c = cos(a.val);
+    return hyper_chain(a, s, c, -s);
+}
+
+static inline HyperDual hyper_cos(HyperDual a)
+{
+    double s = sin(a.val), c = cos(a.val);
+    return hyper_chain(a, c, -s, -c);
+}
+
+#endif // DUAL_H
@@ -0,0 +1,500 @@
+// Runtime expression engine
+// Compiles an expression such as "x*exp(x)-cos(x)" once into compact stack bytecode
+// and evaluates it for one point or for a batch of points, EXPR_LANES at a time.
+//
+// Variables: x, y      Constants: pi, e
+// Operators: + - * / ^ (right associative), unary -
+// Functions: sin cos tan asin acos atan sinh cosh tanh exp log (= ln) ln log10 sqrt abs pow(a, b)
+//
+// Header only: include it from any program with #include "../common/expression.h" and link with -lm.
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define EXPR_MAX_CODE 256 // Maximum number of bytecode instructions
+#define EXPR_MAX_STACK 32 // Maximum evaluation stack depth
+#define EXPR_LANES 8      // Points evaluated per instruction in expr_eval_batch
+#define EXPR_MAX_NESTING 64 // Maximum parser recursion (parentheses, calls, signs, powers)
+
+// Bytecode operations
+typedef enum
+{
+    OP_CONST,
+    OP_X,
+    OP_Y,
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_POW,
+    OP_NEG,
+    OP_SIN,
+    OP_COS,
+    OP_TAN,
+    OP_ASIN,
+    OP_ACOS,
+    OP_ATAN,
+    OP_SINH,
+    OP_COSH,
+    OP_TANH,
+    OP_EXP,
+    OP_LOG,
+    OP_LOG10,
+    OP_SQRT,
+    OP_ABS
+} ExprOp;
+
+// One bytecode instruction
+typedef struct
+{
+    ExprOp op;
+    double value; // Only used by OP_CONST
+} ExprInstruction;
+
+// A compiled expression
+typedef struct
+{
+    ExprInstruction code[EXPR_MAX_CODE];
+    int length;
+    int depth; // Current stack depth while compiling
+    int max_depth;
+    int nesting;      // Current parser recursion depth while compiling
+    const char *text; // Parser cursor while compiling
+    const char *start;
+    int error;
+} Expression;
+
+// Named unary functions
+static const struct
+{
+    const char *name;
+    ExprOp op;
+} expr_functions[] = {
+    {"sin", OP_SIN}, {"cos", OP_COS}, {"tan", OP_TAN}, {"asin", OP_ASIN}, {"acos", OP_ACOS},
+    {"atan", OP_ATAN}, {"sinh", OP_SINH}, {"cosh", OP_COSH}, {"tanh", OP_TANH}, {"exp", OP_EXP},
+    {"log", OP_LOG}, {"ln", OP_LOG}, {"log10", OP_LOG10}, {"sqrt", OP_SQRT}, {"abs", OP_ABS},
+};
+
+// Apply a unary operation to one value
+static inline double expr_apply_unary(ExprOp op, double a)
+{
+    switch (op)
+    {
+    case OP_NEG: return -a;
+    case OP_SIN: return sin(a);
+    case OP_COS: return cos(a);
+    case OP_TAN: return tan(a);
+    case OP_ASIN: return asin(a);
+    case OP_ACOS: return acos(a);
+    case OP_ATAN: return atan(a);
+    case OP_SINH: return sinh(a);
+    case OP_COSH: return cosh(a);
+    case OP_TANH: return tanh(a);
+    case OP_EXP: return exp(a);
+    case OP_LOG: return log(a);
+    case OP_LOG10: return log10(a);
+    case OP_SQRT: return sqrt(a);
+    case OP_ABS: return fabs(a);
+    default: return NAN;
+    }
+}
+
+// Apply a binary operation to two values
+static inline double expr_apply_binary(ExprOp op, double a, double b)
+{
+    switch (op)
+    {
+    case OP_ADD: return a + b;
+    case OP_SUB: return a - b;
+    case OP_MUL: return a * b;
+    case OP_DIV: return a / b;
+    case OP_POW: return b == 2.0 ? a * a : pow(a, b);
+    default: return NAN;
+    }
+}
+
+// Report a syntax error with the position where it happened
+static void expr_fail(Expression *e, const char *message)
+{
+    if (!e->error)
+        printf("Error: %s at position %d in expression \"%s\".\n", message, (int)(e->text - e->start), e->start);
+    e->error = 1;
+}
+
+// Append an instruction, folding it into the previous constants where possible
+static void expr_emit(Expression *e, ExprOp op, double value)
+{
+    int n = e->length;
+
+    if (op >= OP_ADD && op <= OP_POW && n >= 2 && e->code[n - 1].op == OP_CONST && e->code[n - 2].op == OP_CONST)
+    {
+        e->code[n - 2].value = expr_apply_binary(op, e->code[n - 2].value, e->code[n - 1].value);
+        e->length--;
+        e->depth--;
+        return;
+    }
+    if (op >= OP_NEG && n >= 1 && e->code[n - 1].op == OP_CONST)
+    {
+        e->code[n - 1].value = expr_apply_unary(op, e->code[n - 1].value);
+        return;
+    }
+
+    if (n >= EXPR_MAX_CODE)
+    {
+        expr_fail(e, "expression too long");
+        return;
+    }
+    e->code[n].op = op;
+    e->code[n].value = value;
+    e->length++;
+
+    // Constants and variables push one value, binary operators pop one
+    if (op <= OP_Y)
+        e->depth++;
+    else if (op <= OP_POW)
+        e->depth--;
+    if (e->depth > e->max_depth)
+        e->max_depth = e->depth;
+    if (e->max_depth > EXPR_MAX_STACK)
+        expr_fail(e, "expression nested too deeply");
+}
+
+static void expr_skip_spaces(Expression *e)
+{
+    while (isspace((unsigned char)*e->text))
+        e->text++;
+}
+
+static void expr_parse_sum(Expression *e);
+static void expr_parse_unary(Expression *e);
+
+// primary := number | x | y | pi | e | name '(' sum [',' sum] ')' | '(' sum ')'
+static void expr_parse_primary(Expression *e)
+{
+    expr_skip_spaces(e);
+    const char *p = e->text;
+
+    if (isdigit((unsigned char)*p) || *p == '.')
+    {
+        char *end;
+        double value = strtod(p, &end);
+        e->text = end;
+        expr_emit(e, OP_CONST, value);
+        return;
+    }
+
+    if (*p == '(')
+    {
+        e->text++;
+        expr_parse_sum(e);
+        expr_skip_spaces(e);
+        if (*e->text != ')')
+        {
+            expr_fail(e, "expected ')'");
+            return;
+        }
+        e->text++;
+        return;
+    }
+
+    if (!isalpha((unsigned char)*p))
+    {
+        expr_fail(e, "unexpected character");
+        return;
+    }
+
+    // Read an identifier
+    char name[16];
+    int len = 0;
+    while (isalnum((unsigned char)*p) || *p == '_')
+    {
+        if (len < (int)sizeof(name) - 1)
+            name[len++] = *p;
+        p++;
+    }
+    name[len] = '\0';
+    e->text = p;
+
+    if (strcmp(name, "x") == 0)
+        expr_emit(e, OP_X, 0.0);
+    else if (strcmp(name, "y") == 0)
+        expr_emit(e, OP_Y, 0.0);
+    else if (strcmp(name, "pi") == 0)
+        expr_emit(e, OP_CONST, M_PI);
+    else if (strcmp(name, "e") == 0)
+        expr_emit(e, OP_CONST, M_E);
+    else
+    {
+        // Function call
+        ExprOp op = OP_CONST;
+        int is_pow = strcmp(name, "pow") == 0;
+        for (size_t i = 0; i < sizeof(expr_functions) / sizeof(expr_functions[0]); i++)
+        {
+            if (strcmp(name, expr_functions[i].name) == 0)
+                op = expr_functions[i].op;
+        }
+        if (op == OP_CONST && !is_pow)
+        {
+            expr_fail(e, "unknown name");
+            return;
+        }
+
+        expr_skip_spaces(e);
+        if (*e->text != '(')
+        {
+            expr_fail(e, "expected '(' after function name");
+            return;
+        }
+        e->text++;
+        expr_parse_sum(e);
+        if (is_pow)
+        {
+            expr_skip_spaces(e);
+            if (*e->text != ',')
+            {
+                expr_fail(e, "expected ',' in pow(a, b)");
+                return;
+            }
+            e->text++;
+            expr_parse_sum(e);
+            op = OP_POW;
+        }
+        expr_skip_spaces(e);
+        if (*e->text != ')')
+        {
+            expr_fail(e, "expected ')'");
+            return;
+        }
+        e->text++;
+        expr_emit(e, op, 0.0);
+    }
+}
+
+// power := primary ['^' unary]
+static void expr_parse_power(Expression *e)
+{
+    expr_parse_primary(e);
+    expr_skip_spaces(e);
+    if (*e->text == '^')
+    {
+        e->text++;
+        expr_parse_unary(e);
+        expr_emit(e, OP_POW, 0.0);
+    }
+}
+
+// unary := ('-' | '+') unary | power
+// Every recursive path of the grammar passes through here, so this is where the nesting
+// is limited: without a limit "((((...x" or "----...x" would overflow the C stack.
+static void expr_parse_unary(Expression *e)
+{
+    if (e->error)
+        return;
+    if (e->nesting >= EXPR_MAX_NESTING)
+    {
+        expr_fail(e, "too many nested parentheses, functions or signs");
+        return;
+    }
+    e->nesting++;
+
+    expr_skip_spaces(e);
+    if (*e->text == '-')
+    {
+        e->text++;
+        expr_parse_unary(e);
+        expr_emit(e, OP_NEG, 0.0);
+    }
+    else if (*e->text == '+')
+    {
+        e->text++;
+        expr_parse_unary(e);
+    }
+    else
+        expr_parse_power(e);
+
+    e->nesting--;
+}
+
+// product := unary (('*' | '/') unary)*
+static void expr_parse_product(Expression *e)
+{
+    expr_parse_unary(e);
+    while (!e->error)
+    {
+        expr_skip_spaces(e);
+        char c = *e->text;
+        if (c != '*' && c != '/')
+            break;
+        e->text++;
+        expr_parse_unary(e);
+        expr_emit(e, c == '*' ? OP_MUL : OP_DIV, 0.0);
+    }
+}
+
+// sum := product (('+' | '-') product)*
+static void expr_parse_sum(Expression *e)
+{
+    expr_parse_product(e);
+    while (!e->error)
+    {
+        expr_skip_spaces(e);
+        char c = *e->text;
+        if (c != '+' && c != '-')
+            break;
+        e->text++;
+        expr_parse_product(e);
+        expr_emit(e, c == '+' ? OP_ADD : OP_SUB, 0.0);
+    }
+}
+
+// Compile text into e. Returns 0 on success, -1 (after printing the error) otherwise.
+static inline int expr_compile(Expression *e, const char *text)
+{
+    memset(e, 0, sizeof(*e));
+    e->text = e->start = text;
+
+    expr_parse_sum(e);
+    expr_skip_spaces(e);
+    if (!e->error && *e->text != '\0')
+        expr_fail(e, "unexpected trailing input");
+
+    e->text = e->start = NULL;
+    return e->error ? -1 : 0;
+}
+
+// Evaluate the expression at a single point (x, y)
+static inline double expr_eval(const Expression *e, double x, double y)
+{
+    double stack[EXPR_MAX_STACK];
+    int top = -1;
+
+    for (int i = 0; i < e->length; i++)
+    {
+        ExprOp op = e->code[i].op;
+        switch (op)
+        {
+        case OP_CONST: stack[++top] = e->code[i].value; break;
+        case OP_X: stack[++top] = x; break;
+        case OP_Y: stack[++top] = y; break;
+        case OP_ADD: top--; stack[top] += stack[top + 1]; break;
+        case OP_SUB: top--; stack[top] -= stack[top + 1]; break;
+        case OP_MUL: top--; stack[top] *= stack[top + 1]; break;
+        case OP_DIV: top--; stack[top] /= stack[top + 1]; break;
+        case OP_POW: top--; stack[top] = expr_apply_binary(OP_POW, stack[top], stack[top + 1]); break;
+        default: stack[top] = expr_apply_unary(op, stack[top]); break;
+        }
+    }
+
+    return stack[0];
+}
+
+// Evaluate out[i] = expr(x[i], y[i]) for i = 0 .. n-1; y may be NULL.
+// Each instruction is dispatched once per EXPR_LANES points, so the interpreter
+// overhead is amortized and the fixed-width lane loops auto-vectorize at -O3.
+static inline void expr_eval_batch(const Expression *e, const double x[], const double y[], double out[], int n)
+{
+    double stack[EXPR_MAX_STACK][EXPR_LANES];
+
+    for (int start = 0; start < n; start += EXPR_LANES)
+    {
+        int lanes = n - start < EXPR_LANES ? n - start : EXPR_LANES;
+        const double *xs = x + start;
+        const double *ys = y ? y + start : NULL;
+        int top = -1;
+
+        for (int i = 0; i < e->length; i++)
+        {
+            ExprOp op = e->code[i].op;
+            double *s = stack[top >= 0 ? top : 0];         // Top of stack
+            double *t = stack[top + 1 < EXPR_MAX_STACK ? top + 1 : 0]; // Slot for a push
+
+            switch (op)
+            {
+            case OP_CONST:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    t[l] = e->code[i].value;
+                top++;
+                break;
+            case OP_X:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    t[l] = l < lanes ? xs[l] : 0.0;
+                top++;
+                break;
+            case OP_Y:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    t[l] = ys && l < lanes ? ys[l] : 0.0;
+                top++;
+                break;
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+            case OP_POW:
+            {
+                double *a = stack[top - 1];
+                if (op == OP_ADD)
+                {
+                    for (int l = 0; l < EXPR_LANES; l++)
+                        a[l] += s[l];
+                }
+                else if (op == OP_SUB)
+                {
+                    for (int l = 0; l < EXPR_LANES; l++)
+                        a[l] -= s[l];
+                }
+                else if (op == OP_MUL)
+                {
+                    for (int l = 0; l < EXPR_LANES; l++)
+                        a[l] *= s[l];
+                }
+                else if (op == OP_DIV)
+                {
+                    for (int l = 0; l < EXPR_LANES; l++)
+                        a[l] /= s[l];
+                }
+                else
+                {
+                    for (int l = 0; l < EXPR_LANES; l++)
+                        a[l] = expr_apply_binary(OP_POW, a[l], s[l]);
+                }
+                top--;
+                break;
+            }
+            case OP_NEG:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = -s[l];
+                break;
+            case OP_EXP:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = exp(s[l]);
+                break;
+            case OP_SIN:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = sin(s[l]);
+                break;
+            case OP_COS:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = cos(s[l]);
+                break;
+            case OP_LOG:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = log(s[l]);
+                break;
+            default:
+                for (int l = 0; l < EXPR_LANES; l++)
+                    s[l] = expr_apply_unary(op, s[l]);
+                break;
+            }
+        }
+
+        for (int l = 0; l < lanes; l++)
+            out[start + l] = stack[0][l];
+    }
+}
+
+#endif // EXPRESSION_H
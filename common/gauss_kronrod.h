@@ -0,0 +1,175 @@
+// Adaptive Gauss-Kronrod quadrature
+// gauss_kronrod() integrates f over [a, b] with the 15-point Kronrod rule and its embedded
+// 7-point Gauss rule. The difference of the two estimates the error of each subinterval; the
+// subintervals sit in a max-heap keyed on that error, and the worst one is bisected until
+//     total error <= max(abs_tol, rel_tol * |integral|)
+// so evaluations go where the integrand is hard (peaks, kinks, endpoint singularities).
+//
+// Header only: include it with #include "../common/gauss_kronrod.h" and link with -lm.
+#ifndef GAUSS_KRONROD_H
+#define GAUSS_KRONROD_H
+
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "integration.h"
+
+#define GK_POINTS 15
+
+// One subinterval of the adaptive partition
+typedef struct
+{
+    double a, b;
+    double value;
+    double error;
+} GKInterval;
+
+// Kronrod abscissae on [-1, 1] (positive half, xgk[1], xgk[3], xgk[5], xgk[7] are the Gauss points)
+static const double gk_x[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+
+// Kronrod weights
+static const double gk_wk[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+
+// Gauss weights for xgk[1], xgk[3], xgk[5], xgk[7]
+static const double gk_wg[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+// G7-K15 on [a, b]; the error estimate follows QUADPACK's qk15
+static GKInterval gk15(double (*f)(double), double a, double b)
+{
+    double center = 0.5 * (a + b), half = 0.5 * (b - a);
+    double fv1[7], fv2[7];
+    double fc = f(center);
+    double resk = fc * gk_wk[7], resg = fc * gk_wg[3], resabs = fabs(resk);
+
+    for (int j = 0; j < 7; j++)
+    {
+        double dx = half * gk_x[j];
+        fv1[j] = f(center - dx);
+        fv2[j] = f(center + dx);
+        resk += gk_wk[j] * (fv1[j] + fv2[j]);
+        resabs += gk_wk[j] * (fabs(fv1[j]) + fabs(fv2[j]));
+        if (j % 2 == 1)
+            resg += gk_wg[j / 2] * (fv1[j] + fv2[j]);
+    }
+
+    // resasc: integral of |f - mean|, used to scale the raw Gauss-Kronrod difference
+    double mean = 0.5 * resk, resasc = gk_wk[7] * fabs(fc - mean);
+    for (int j = 0; j < 7; j++)
+        resasc += gk_wk[j] * (fabs(fv1[j] - mean) + fabs(fv2[j] - mean));
+
+    double error = fabs((resk - resg) * half);
+    resasc *= fabs(half);
+    resabs *= fabs(half);
+    if (resasc != 0.0 && error != 0.0)
+        error = resasc * fmin(1.0, pow(200.0 * error / resasc, 1.5));
+    if (resabs > DBL_MIN / (50.0 * DBL_EPSILON))
+        error = fmax(50.0 * DBL_EPSILON * resabs, error);
+
+    return (GKInterval){a, b, resk * half, error};
+}
+
+// Restore the heap property upwards from index i
+static void gk_sift_up(GKInterval heap[], int i)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (heap[parent].error >= heap[i].error)
+            break;
+        GKInterval t = heap[parent];
+        heap[parent] = heap[i];
+        heap[i] = t;
+        i = parent;
+    }
+}
+
+// Restore the heap property downwards from index i
+static void gk_sift_down(GKInterval heap[], int count, int i)
+{
+    for (;;)
+    {
+        int largest = i, left = 2 * i + 1, right = 2 * i + 2;
+        if (left < count && heap[left].error > heap[largest].error)
+            largest = left;
+        if (right < count && heap[right].error > heap[largest].error)
+            largest = right;
+        if (largest == i)
+            break;
+        GKInterval t = heap[largest];
+        heap[largest] = heap[i];
+        heap[i] = t;
+        i = largest;
+    }
+}
+
+// Integrate f over [a, b] using at most max_intervals subintervals.
+// Returns 0 when the tolerance was met, 1 if max_intervals was reached first
+// (result still holds the best estimate) and -1 on allocation failure.
+static inline int gauss_kronrod(double (*f)(double), double a, double b, double abs_tol, double rel_tol,
+                                int max_intervals, QuadratureResult *result)
+{
+    if (max_intervals < 1)
+        max_intervals = 1;
+
+    GKInterval *heap = malloc(max_intervals * sizeof(GKInterval));
+    if (!heap)
+        return -1;
+
+    int count = 1, status = 1;
+    heap[0] = gk15(f, a, b);
+    double value = heap[0].value, error = heap[0].error;
+    result->evaluations = GK_POINTS;
+
+    while (count < max_intervals)
+    {
+        if (error <= fmax(abs_tol, rel_tol * fabs(value)))
+        {
+            status = 0;
+            break;
+        }
+
+        // Split the subinterval with the largest error
+        GKInterval worst = heap[0];
+        double mid = 0.5 * (worst.a + worst.b);
+        GKInterval left = gk15(f, worst.a, mid), right = gk15(f, mid, worst.b);
+        result->evaluations += 2 * GK_POINTS;
+
+        value += left.value + right.value - worst.value;
+        error += left.error + right.error - worst.error;
+
+        heap[0] = left;
+        gk_sift_down(heap, count, 0);
+        heap[count] = right;
+        gk_sift_up(heap, count);
+        count++;
+    }
+
+    // Re-add the totals so the running updates leave no drift
+    value = 0.0;
+    error = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        value += heap[i].value;
+        error += heap[i].error;
+    }
+    if (status == 1 && error <= fmax(abs_tol, rel_tol * fabs(value)))
+        status = 0;
+
+    result->value = value;
+    result->error = error;
+    result->intervals = count;
+    free(heap);
+    return status;
+}
+
+#endif
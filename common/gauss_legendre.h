@@ -0,0 +1,356 @@
+// Gauss-Legendre and Gauss-Lobatto quadrature
+// gauss_rule() returns the n-point rule on [-1, 1]:
+//     GAUSS_LEGENDRE  nodes are the roots of P_n, exact for polynomials of degree 2n - 1
+//     GAUSS_LOBATTO   nodes are +-1 and the roots of P'_(n-1), exact for degree 2n - 3
+// Orders up to GAUSS_TABLE_ORDER come from the precomputed tables below (positive half,
+// 21 digits). Larger orders are found once by Newton iteration on the three-term Legendre
+// recurrence and cached, so each rule is computed only once per program. Each node costs
+// O(n) per Newton step, so building an n-point rule is O(n^2); that is about 10 ms for
+// n = 1000, paid once.
+//     gauss_integrate()        one panel
+//     gauss_composite()        panels of equal width
+//     gauss_composite_batch()  the same, with a batch integrand called once per block of
+//                              abscissae so the weighted sum runs as a SIMD loop
+//
+// Header only: include it with #include "../common/gauss_legendre.h" and link with -lm.
+#ifndef GAUSS_LEGENDRE_H
+#define GAUSS_LEGENDRE_H
+
+#include <stdlib.h>
+#include <math.h>
+#include <stdatomic.h>
+
+#define GAUSS_TABLE_ORDER 10
+#define GAUSS_MAX_ORDER 4096
+#define GAUSS_BLOCK 512 // Abscissae per call of a batch integrand
+
+typedef enum
+{
+    GAUSS_LEGENDRE = 0,
+    GAUSS_LOBATTO
+} GaussKind;
+
+// An n-point rule on [-1, 1], nodes in ascending order
+typedef struct
+{
+    int n;
+    double *x;
+    double *w;
+} GaussRule;
+
+// Integrand evaluated on an array of abscissae
+typedef void (*gauss_batch_function)(const double x[], double fx[], int n);
+
+// Nodes and weights {x, w} for x >= 0, orders 2 to GAUSS_TABLE_ORDER, largest node first
+static const double gauss_legendre_table[][2] = {
+    // n = 2
+    {0.577350269189625764509, 1.000000000000000000000},
+    // n = 3
+    {0.774596669241483377036, 0.555555555555555555556},
+    {0.000000000000000000000, 0.888888888888888888889},
+    // n = 4
+    {0.861136311594052575224, 0.347854845137453857373},
+    {0.339981043584856264803, 0.652145154862546142627},
+    // n = 5
+    {0.906179845938663992798, 0.236926885056189087514},
+    {0.538469310105683091036, 0.478628670499366468041},
+    {0.000000000000000000000, 0.568888888888888888889},
+    // n = 6
+    {0.932469514203152027812, 0.171324492379170345040},
+    {0.661209386466264513661, 0.360761573048138607570},
+    {0.238619186083196908631, 0.467913934572691047390},
+    // n = 7
+    {0.949107912342758524526, 0.129484966168869693271},
+    {0.741531185599394439864, 0.279705391489276667901},
+    {0.405845151377397166907, 0.381830050505118944950},
+    {0.000000000000000000000, 0.417959183673469387755},
+    // n = 8
+    {0.960289856497536231684, 0.101228536290376259153},
+    {0.796666477413626739592, 0.222381034453374470544},
+    {0.525532409916328985818, 0.313706645877887287338},
+    {0.183434642495649804939, 0.362683783378361982965},
+    // n = 9
+    {0.968160239507626089836, 0.081274388361574411972},
+    {0.836031107326635794299, 0.180648160694857404058},
+    {0.613371432700590397309, 0.260610696402935462319},
+    {0.324253423403808929039, 0.312347077040002840069},
+    {0.000000000000000000000, 0.330239355001259763165},
+    // n = 10
+    {0.973906528517171720078, 0.066671344308688137594},
+    {0.865063366688984510732, 0.149451349150580593146},
+    {0.679409568299024406234, 0.219086362515982043996},
+    {0.433395394129247190799, 0.269266719309996355091},
+    {0.148874338981631210885, 0.295524224714752870174},
+};
+
+// Lobatto nodes and weights {x, w} for x >= 0, orders 3 to GAUSS_TABLE_ORDER
+static const double gauss_lobatto_table[][2] = {
+    // n = 3
+    {1.000000000000000000000, 0.333333333333333333333},
+    {0.000000000000000000000, 1.333333333333333333333},
+    // n = 4
+    {1.000000000000000000000, 0.166666666666666666667},
+    {0.447213595499957939282, 0.833333333333333333333},
+    // n = 5
+    {1.000000000000000000000, 0.100000000000000000000},
+    {0.654653670707977143798, 0.544444444444444444444},
+    {0.000000000000000000000, 0.711111111111111111111},
+    // n = 6
+    {1.000000000000000000000, 0.066666666666666666667},
+    {0.765055323929464692851, 0.378474956297846980317},
+    {0.285231516480645096314, 0.554858377035486353017},
+    // n = 7
+    {1.000000000000000000000, 0.047619047619047619048},
+    {0.830223896278566929872, 0.276826047361565948011},
+    {0.468848793470714213804, 0.431745381209862623418},
+    {0.000000000000000000000, 0.487619047619047619048},
+    // n = 8
+    {1.000000000000000000000, 0.035714285714285714286},
+    {0.871740148509606615337, 0.210704227143506039383},
+    {0.591700181433142302145, 0.341122692483504364764},
+    {0.209299217902478868769, 0.412458794658703881567},
+    // n = 9
+    {1.000000000000000000000, 0.027777777777777777778},
+    {0.899757995411460157312, 0.165495361560805525046},
+    {0.677186279510737753446, 0.274538712500161735281},
+    {0.363117463826178158711, 0.346428510973046345115},
+    {0.000000000000000000000, 0.371519274376417233560},
+    // n = 10
+    {1.000000000000000000000, 0.022222222222222222222},
+    {0.919533908166458813829, 0.133305990851070111126},
+    {0.738773865105505075003, 0.224889342063126452119},
+    {0.477924949810444495661, 0.292042683679683757876},
+    {0.165278957666387024626, 0.327539761183897456657},
+};
+
+// Lobatto orders start at 3 (n = 2 is the trapezoidal rule)
+#define GAUSS_LOBATTO_MIN_ORDER 3
+
+static GaussRule gauss_cache[2][GAUSS_MAX_ORDER + 1];
+static atomic_int gauss_ready[2][GAUSS_MAX_ORDER + 1]; // Set once the cached rule is complete
+
+// P_n(x) and P_(n-1)(x) by the three-term recurrence
+static void gauss_legendre_p(int n, double x, double *p, double *p_previous)
+{
+    double p0 = 1.0, p1 = x;
+    for (int k = 2; k <= n; k++)
+    {
+        double p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+        p0 = p1;
+        p1 = p2;
+    }
+    *p = n == 0 ? 1.0 : p1;
+    *p_previous = n == 0 ? 0.0 : p0;
+}
+
+// Positive-half node k (k = 0 is the largest) and its weight, by Newton iteration
+static void gauss_newton_node(GaussKind kind, int n, int k, double *x, double *w)
+{
+    double p, q;
+
+    if (kind == GAUSS_LEGENDRE)
+    {
+        double t = cos(M_PI * (k + 0.75) / (n + 0.5));
+        for (int it = 0; it < 100; it++)
+        {
+            gauss_legendre_p(n, t, &p, &q);
+            double dp = n * (t * p - q) / (t * t - 1.0);
+            double dt = p / dp;
+            t -= dt;
+            if (fabs(dt) < 1e-16)
+                break;
+        }
+        gauss_legendre_p(n, t, &p, &q);
+        double dp = n * (t * p - q) / (t * t - 1.0);
+        *x = t;
+        *w = 2.0 / ((1.0 - t * t) * dp * dp);
+        return;
+    }
+
+    // Lobatto: node 0 is the endpoint, the others are roots of (1 - x^2) P'_m, m = n - 1,
+    // whose derivative is -m (m + 1) P_m
+    int m = n - 1;
+    if (k == 0)
+    {
+        *x = 1.0;
+        *w = 2.0 / (n * m);
+        return;
+    }
+    double t = 0.5 * (cos(M_PI * (k - 0.25) / (m + 0.5)) + cos(M_PI * (k + 0.75) / (m + 0.5)));
+    for (int it = 0; it < 100; it++)
+    {
+        gauss_legendre_p(m, t, &p, &q);
+        double dt = m * (q - t * p) / (-m * (m + 1.0) * p);
+        t -= dt;
+        if (fabs(dt) < 1e-16)
+            break;
+    }
+    gauss_legendre_p(m, t, &p, &q);
+    *x = t;
+    *w = 2.0 / (n * m * p * p);
+}
+
+// Fill the rule from the table or by Newton iteration; returns 0 or -1 on allocation failure
+static int gauss_build(GaussKind kind, int n, GaussRule *rule)
+{
+    double *x = malloc(2 * n * sizeof(double));
+    if (!x)
+        return -1;
+
+    // Offset of order n in the table
+    int first = kind == GAUSS_LEGENDRE ? 2 : GAUSS_LOBATTO_MIN_ORDER, offset = 0;
+    for (int m = first; m < n; m++)
+        offset += (m + 1) / 2;
+
+    for (int k = 0; k < (n + 1) / 2; k++)
+    {
+        double node, weight;
+        if (n <= GAUSS_TABLE_ORDER)
+        {
+            const double *entry = kind == GAUSS_LEGENDRE ? gauss_legendre_table[offset + k] : gauss_lobatto_table[offset + k];
+            node = entry[0];
+            weight = entry[1];
+        }
+        else
+            gauss_newton_node(kind, n, k, &node, &weight);
+
+        // Mirror into ascending order: index n - 1 - k holds +node, index k holds -node
+        x[n - 1 - k] = node;
+        x[k] = -node;
+        x[n + n - 1 - k] = weight;
+        x[n + k] = weight;
+    }
+    if (n % 2 == 1)
+        x[n / 2] = 0.0;
+
+    rule->n = n;
+    rule->x = x;
+    rule->w = x + n;
+    return 0;
+}
+
+// The n-point rule, or NULL if n is out of range or memory ran out.
+// Safe to call from several threads; the rule stays valid until gauss_free_cache().
+// A rule already built is returned without locking: gauss_ready is stored with release
+// order after the rule is filled in, so a thread that loads it with acquire order sees the
+// whole rule. Only building a missing rule takes the lock.
+static inline const GaussRule *gauss_rule(GaussKind kind, int n)
+{
+    int min_order = kind == GAUSS_LEGENDRE ? 1 : GAUSS_LOBATTO_MIN_ORDER;
+    if (n < min_order || n > GAUSS_MAX_ORDER)
+        return NULL;
+
+    GaussRule *rule = &gauss_cache[kind][n];
+    if (atomic_load_explicit(&gauss_ready[kind][n], memory_order_acquire))
+        return rule;
+
+    int failed = 0;
+#ifdef _OPENMP
+#pragma omp critical(gauss_cache)
+#endif
+    {
+        if (!atomic_load_explicit(&gauss_ready[kind][n], memory_order_relaxed))
+        {
+            if (n == 1)
+            {
+                // Midpoint rule
+                double *x = malloc(2 * sizeof(double));
+                if (x)
+                {
+                    x[0] = 0.0;
+                    x[1] = 2.0;
+                    *rule = (GaussRule){1, x, x + 1};
+                }
+                else
+                    failed = 1;
+            }
+            else
+                failed = gauss_build(kind, n, rule) != 0;
+            if (!failed)
+                atomic_store_explicit(&gauss_ready[kind][n], 1, memory_order_release);
+        }
+    }
+    return failed ? NULL : rule;
+}
+
+// Release every cached rule; no thread may be using a rule or calling gauss_rule()
+static inline void gauss_free_cache(void)
+{
+    for (int kind = 0; kind < 2; kind++)
+    {
+        for (int n = 0; n <= GAUSS_MAX_ORDER; n++)
+        {
+            atomic_store(&gauss_ready[kind][n], 0);
+            free(gauss_cache[kind][n].x);
+            gauss_cache[kind][n] = (GaussRule){0, NULL, NULL};
+        }
+    }
+}
+
+// Integral of f over [a, b] with one panel
+static inline double gauss_integrate(const GaussRule *rule, double (*f)(double), double a, double b)
+{
+    double center = 0.5 * (a + b), half = 0.5 * (b - a), sum = 0.0;
+    for (int i = 0; i < rule->n; i++)
+        sum += rule->w[i] * f(center + half * rule->x[i]);
+    return sum * half;
+}
+
+// Integral of f over [a, b] split into equal panels
+static inline double gauss_composite(const GaussRule *rule, double (*f)(double), double a, double b, long panels)
+{
+    double h = (b - a) / panels, sum = 0.0;
+    for (long p = 0; p < panels; p++)
+        sum += gauss_integrate(rule, f, a + p * h, a + (p + 1) * h);
+    return sum;
+}
+
+// Same as gauss_composite() with a batch integrand. The offsets and weights of a block of
+// panels are laid out once, so generating the abscissae and applying the weights are both
+// single vectorizable loops.
+static inline double gauss_composite_batch(const GaussRule *rule, gauss_batch_function f, double a, double b, long panels)
+{
+    int n = rule->n;
+    int per_block = GAUSS_BLOCK / n > 0 ? GAUSS_BLOCK / n : 1;
+    int size = per_block * n;
+    double h = (b - a) / panels, sum = 0.0;
+    double *offset = malloc(4 * (size_t)size * sizeof(double));
+
+    if (!offset)
+        return NAN;
+    double *weight = offset + size, *x = weight + size, *fx = x + size;
+
+    for (int p = 0; p < per_block; p++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            offset[p * n + i] = (p + 0.5 + 0.5 * rule->x[i]) * h;
+            weight[p * n + i] = rule->w[i];
+        }
+    }
+
+    for (long p0 = 0; p0 < panels; p0 += per_block)
+    {
+        int count = (panels - p0 < per_block ? (int)(panels - p0) : per_block) * n;
+        double left = a + p0 * h, block = 0.0;
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (int j = 0; j < count; j++)
+            x[j] = left + offset[j];
+        f(x, fx, count);
+
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : block)
+#endif
+        for (int j = 0; j < count; j++)
+            block += weight[j] * fx[j];
+        sum += block;
+    }
+
+    free(offset);
+    return sum * 0.5 * h;
+}
+
+#endif
@@ -0,0 +1,135 @@
+// Parallel composite Newton-Cotes rules
+// The composite rules of 04-general-quadratic-formula/01-numerical-integration.c, split across
+// threads for very large n (10^9 and beyond):
+//     trapezoidal_parallel()  weights 1 2 2 ... 2 1
+//     simpsons_13_parallel()  weights 1 4 2 4 ... 2 4 1
+//     simpsons_38_parallel()  weights 1 3 3 2 3 3 2 ... 3 3 1
+// The interior weights repeat with a short period, so each loop steps through the pattern
+// with a wrapping counter instead of testing i % 2 or i % 3. Every block of INTEGRATION_BLOCK
+// terms is summed directly and the block sums are added with Neumaier (improved Kahan)
+// compensation, so the rounding error does not grow with n.
+//
+// Header only: include it with #include "../common/integration.h", compile with -fopenmp
+// for threads (the rules run serially without it) and link with -lm.
+#ifndef INTEGRATION_H
+#define INTEGRATION_H
+
+#include <math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define INTEGRATION_BLOCK 256 // Terms summed directly before compensation
+
+// Compensated running sum
+typedef struct
+{
+    double sum;
+    double c; // Lost low-order bits
+} KahanSum;
+
+// Result of an adaptive or refining integration
+typedef struct
+{
+    double value;     // Integral estimate
+    double error;     // Estimated absolute error
+    long evaluations; // Calls to f
+    int intervals;    // Subintervals in the final partition (or refinement levels)
+} QuadratureResult;
+
+// Add x to s (Neumaier's variant also handles |x| > |sum|)
+static inline void kahan_add(KahanSum *s, double x)
+{
+    double t = s->sum + x;
+    if (fabs(s->sum) >= fabs(x))
+        s->c += (s->sum - t) + x;
+    else
+        s->c += (x - t) + s->sum;
+    s->sum = t;
+}
+
+static inline double kahan_result(const KahanSum *s)
+{
+    return s->sum + s->c;
+}
+
+// Sum of w[i % period] * f(a + i h) for first <= i < last, compensated across blocks
+static double composite_range(double (*f)(double), double a, double h, long first, long last,
+                              const double w[], int period)
+{
+    KahanSum total = {0.0, 0.0};
+    int j = (int)(first % period);
+
+    for (long start = first; start < last; start += INTEGRATION_BLOCK)
+    {
+        long end = start + INTEGRATION_BLOCK < last ? start + INTEGRATION_BLOCK : last;
+        double block = 0.0;
+
+        for (long i = start; i < end; i++)
+        {
+            block += w[j] * f(a + i * h);
+            j = j + 1 == period ? 0 : j + 1;
+        }
+        kahan_add(&total, block);
+    }
+    return kahan_result(&total);
+}
+
+// Interior sum over 1 <= i < n split into one contiguous range per thread
+static double composite_interior(double (*f)(double), double a, double h, long n, const double w[], int period)
+{
+    KahanSum total = {0.0, 0.0};
+
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+        int threads = omp_get_num_threads(), t = omp_get_thread_num();
+        long first = 1 + (n - 1) * t / threads;
+        long last = 1 + (n - 1) * (t + 1) / threads;
+        double partial = composite_range(f, a, h, first, last, w, period);
+
+        // Add the partials in thread order so the result does not depend on timing
+#pragma omp for ordered schedule(static, 1)
+        for (int k = 0; k < threads; k++)
+        {
+#pragma omp ordered
+            kahan_add(&total, partial);
+        }
+    }
+#else
+    kahan_add(&total, composite_range(f, a, h, 1, n, w, period));
+#endif
+
+    return kahan_result(&total);
+}
+
+// Trapezoidal rule with n subintervals
+static inline double trapezoidal_parallel(double (*f)(double), double a, double b, long n)
+{
+    static const double w[] = {2.0};
+    double h = (b - a) / n;
+    return (f(a) + f(b) + composite_interior(f, a, h, n, w, 1)) * h / 2;
+}
+
+// Simpson's 1/3 rule; n is rounded up to an even number
+static inline double simpsons_13_parallel(double (*f)(double), double a, double b, long n)
+{
+    static const double w[] = {2.0, 4.0}; // i even, i odd
+    if (n % 2 != 0)
+        n++;
+    double h = (b - a) / n;
+    return (f(a) + f(b) + composite_interior(f, a, h, n, w, 2)) * h / 3;
+}
+
+// Simpson's 3/8 rule; n is rounded up to a multiple of 3
+static inline double simpsons_38_parallel(double (*f)(double), double a, double b, long n)
+{
+    static const double w[] = {2.0, 3.0, 3.0}; // i % 3 == 0, 1, 2
+    if (n % 3 != 0)
+        n += 3 - (n % 3);
+    double h = (b - a) / n;
+    return (f(a) + f(b) + composite_interior(f, a, h, n, w, 3)) * h * 3 / 8;
+}
+
+#endif
@@ -0,0 +1,320 @@
+// Multiple and polynomial least squares
+// Fits y = b0 + b1 x1 + ... + bp xp to rows streamed in blocks of any size. As in
+// regression_stream.h, the state is mergeable moments rather than raw sums: the means of
+// z = (x1, ..., xp, y) and the centred Gram matrix C = sum (z - mean)(z - mean)^T, so columns
+// far from zero do not cancel and the intercept needs no column of ones.
+//     least_squares_init()    state for p features
+//     least_squares_append()  add a block of rows (row-major X, rows x p), split across threads
+//     least_squares_solve()   coefficients from C_xx b = C_xy by Cholesky, and R^2
+//     polynomial_fit()        degree-d polynomial in x, fitted in the scaled variable
+//                             t = (x - center) / scale on [-1, 1] and converted back
+// Each thread centres a panel of rows, stores it transposed so every column is contiguous,
+// and forms the upper triangle of its Gram matrix (a SYRK) tile by tile, so a tile of
+// columns stays in cache while it is reused. Panels merge into the thread's partial
+// moments (Chan et al.) and the partials merge in thread order.
+//
+// Header only: include it with #include "../common/least_squares.h", compile with -fopenmp
+// for threads and link with -lm.
+#ifndef LEAST_SQUARES_H
+#define LEAST_SQUARES_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define GRAM_TILE 32            // Columns per tile of the Gram matrix
+#define GRAM_PANEL_BYTES 262144 // Size of one centred panel (fits in L2)
+
+// Streaming least-squares state
+typedef struct
+{
+    int p;        // Features (excluding the intercept)
+    long n;       // Rows appended
+    double *mean; // p + 1 means: x1 ... xp, y
+    double *gram; // (p + 1) x (p + 1) centred Gram matrix, upper triangle used
+} LeastSquares;
+
+// Returns 0, or -1 on invalid p or allocation failure
+static inline int least_squares_init(LeastSquares *ls, int p)
+{
+    memset(ls, 0, sizeof(*ls));
+    if (p < 1)
+        return -1;
+    int q = p + 1;
+    ls->mean = calloc((size_t)q * (q + 1), sizeof(double));
+    if (!ls->mean)
+        return -1;
+    ls->gram = ls->mean + q;
+    ls->p = p;
+    return 0;
+}
+
+static inline void least_squares_free(LeastSquares *ls)
+{
+    free(ls->mean);
+    memset(ls, 0, sizeof(*ls));
+}
+
+// Merge the moments (n_b, mean_b, gram_b) into (n_a, mean_a, gram_a); q columns
+static void gram_merge(int q, long *n_a, double *mean_a, double *gram_a, long n_b, const double *mean_b,
+                       const double *gram_b, double *delta)
+{
+    if (n_b == 0)
+        return;
+    double n = (double)*n_a + n_b, w = (double)*n_a * n_b / n;
+
+    for (int j = 0; j < q; j++)
+        delta[j] = mean_b[j] - mean_a[j];
+    for (int i = 0; i < q; i++)
+    {
+        for (int j = i; j < q; j++)
+            gram_a[i * q + j] += gram_b[i * q + j] + delta[i] * delta[j] * w;
+        mean_a[i] += delta[i] * n_b / n;
+    }
+    *n_a += n_b;
+}
+
+// Moments of rows first <= r < last; panel holds q * panel_rows doubles and block_gram
+// q * q doubles of scratch
+static void gram_range(int p, const double *X, const double *y, long first, long last, long *n, double *mean,
+                       double *gram, double *panel, int panel_rows, double *block_mean, double *block_gram,
+                       double *delta)
+{
+    int q = p + 1;
+
+    for (long start = first; start < last; start += panel_rows)
+    {
+        int rows = (int)(last - start < panel_rows ? last - start : panel_rows);
+
+        // Panel means, then the centred panel stored by column
+        for (int j = 0; j < q; j++)
+            block_mean[j] = 0.0;
+        for (int r = 0; r < rows; r++)
+        {
+            const double *row = X + (start + r) * p;
+            for (int j = 0; j < p; j++)
+                block_mean[j] += row[j];
+            block_mean[p] += y[start + r];
+        }
+        for (int j = 0; j < q; j++)
+            block_mean[j] /= rows;
+        for (int r = 0; r < rows; r++)
+        {
+            const double *row = X + (start + r) * p;
+            for (int j = 0; j < p; j++)
+                panel[j * panel_rows + r] = row[j] - block_mean[j];
+            panel[p * panel_rows + r] = y[start + r] - block_mean[p];
+        }
+
+        // Upper triangle of panel^T panel, one tile of columns against another
+        for (int it = 0; it < q; it += GRAM_TILE)
+        {
+            int i_end = it + GRAM_TILE < q ? it + GRAM_TILE : q;
+            for (int jt = it; jt < q; jt += GRAM_TILE)
+            {
+                int j_end = jt + GRAM_TILE < q ? jt + GRAM_TILE : q;
+                for (int i = it; i < i_end; i++)
+                {
+                    const double *a = panel + (long)i * panel_rows;
+                    for (int j = jt > i ? jt : i; j < j_end; j++)
+                    {
+                        const double *b = panel + (long)j * panel_rows;
+                        double sum = 0.0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+                        for (int r = 0; r < rows; r++)
+                            sum += a[r] * b[r];
+                        block_gram[i * q + j] = sum;
+                    }
+                }
+            }
+        }
+
+        gram_merge(q, n, mean, gram, rows, block_mean, block_gram, delta);
+    }
+}
+
+// Add rows of X (row-major, rows x p) and y; returns 0, or -1 on allocation failure
+static inline int least_squares_append(LeastSquares *ls, const double *X, const double *y, long rows)
+{
+    int p = ls->p, q = p + 1, failed = 0;
+    int panel_rows = GRAM_PANEL_BYTES / (int)sizeof(double) / q;
+    if (panel_rows < 16)
+        panel_rows = 16;
+
+#ifdef _OPENMP
+#pragma omp parallel if (rows > 4 * panel_rows)
+#endif
+    {
+        int threads = 1, t = 0;
+#ifdef _OPENMP
+        threads = omp_get_num_threads();
+        t = omp_get_thread_num();
+#endif
+        // Scratch: panel, partial mean and Gram, panel mean and Gram, delta
+        double *scratch = calloc((size_t)q * panel_rows + 2 * (size_t)q * q + 3 * (size_t)q, sizeof(double));
+        long n = 0;
+        double *gram = NULL, *block_gram, *mean = NULL, *block_mean, *delta = NULL;
+        if (scratch)
+        {
+            gram = scratch + (size_t)q * panel_rows;
+            block_gram = gram + (size_t)q * q;
+            mean = block_gram + (size_t)q * q;
+            block_mean = mean + q;
+            delta = block_mean + q;
+            gram_range(p, X, y, rows * t / threads, rows * (t + 1) / threads, &n, mean, gram, scratch, panel_rows,
+                       block_mean, block_gram, delta);
+        }
+
+        // Merge the partials in thread order so the result does not depend on timing
+#ifdef _OPENMP
+#pragma omp for ordered schedule(static, 1)
+#endif
+        for (int k = 0; k < threads; k++)
+        {
+#ifdef _OPENMP
+#pragma omp ordered
+#endif
+            {
+                if (scratch)
+                    gram_merge(q, &ls->n, ls->mean, ls->gram, n, mean, gram, delta);
+                else
+                    failed = 1;
+            }
+        }
+        free(scratch);
+    }
+    return failed ? -1 : 0;
+}
+
+// Solve for the coefficients: beta[0..p-1] multiply x1..xp. Returns 0, or -1 when C_xx is
+// not positive definite (collinear features or fewer rows than features)
+static inline int least_squares_solve(const LeastSquares *ls, double beta[], double *intercept, double *r2)
+{
+    int p = ls->p, q = p + 1;
+    double *L = malloc((size_t)p * p * sizeof(double));
+    if (!L)
+        return -1;
+
+    // Cholesky C_xx = L L^T (lower triangle of L, row-major), C_xx taken from the upper triangle
+    for (int j = 0; j < p; j++)
+    {
+        double d = ls->gram[j * q + j];
+        for (int k = 0; k < j; k++)
+            d -= L[j * p + k] * L[j * p + k];
+        if (!(d > 1e-12 * ls->gram[j * q + j])) // Also rejects NaN
+        {
+            free(L);
+            return -1;
+        }
+        L[j * p + j] = sqrt(d);
+        for (int i = j + 1; i < p; i++)
+        {
+            double s = ls->gram[j * q + i];
+            for (int k = 0; k < j; k++)
+                s -= L[i * p + k] * L[j * p + k];
+            L[i * p + j] = s / L[j * p + j];
+        }
+    }
+
+    // L u = C_xy, then L^T beta = u
+    for (int i = 0; i < p; i++)
+    {
+        double s = ls->gram[i * q + p];
+        for (int k = 0; k < i; k++)
+            s -= L[i * p + k] * beta[k];
+        beta[i] = s / L[i * p + i];
+    }
+    for (int i = p - 1; i >= 0; i--)
+    {
+        double s = beta[i];
+        for (int k = i + 1; k < p; k++)
+            s -= L[k * p + i] * beta[k];
+        beta[i] = s / L[i * p + i];
+    }
+    free(L);
+
+    double explained = 0.0;
+    *intercept = ls->mean[p];
+    for (int j = 0; j < p; j++)
+    {
+        *intercept -= beta[j] * ls->mean[j];
+        explained += beta[j] * ls->gram[j * q + p];
+    }
+    if (r2)
+        *r2 = ls->gram[p * q + p] > 0.0 ? explained / ls->gram[p * q + p] : 1.0;
+    return 0;
+}
+
+#define POLYNOMIAL_ROWS 4096 // Rows expanded into powers per append
+
+// Least-squares polynomial coef[0] + coef[1] x + ... + coef[degree] x^degree; returns 0,
+// or -1 on allocation failure or a singular system
+static inline int polynomial_fit(const double *x, const double *y, long n, int degree, double coef[], double *r2)
+{
+    if (degree < 1 || n <= degree)
+        return -1;
+
+    // Powers of t = (x - center) / scale, t in [-1, 1], keep the system well conditioned
+    double lo = x[0], hi = x[0];
+    for (long i = 1; i < n; i++)
+    {
+        lo = fmin(lo, x[i]);
+        hi = fmax(hi, x[i]);
+    }
+    double center = 0.5 * (lo + hi), scale = hi > lo ? 0.5 * (hi - lo) : 1.0;
+
+    LeastSquares ls;
+    double *powers = malloc((size_t)POLYNOMIAL_ROWS * degree * sizeof(double));
+    double *c = malloc(((size_t)degree + 1) * sizeof(double));
+    if (!powers || !c || least_squares_init(&ls, degree) != 0)
+    {
+        free(powers);
+        free(c);
+        return -1;
+    }
+
+    int status = 0;
+    for (long start = 0; start < n && status == 0; start += POLYNOMIAL_ROWS)
+    {
+        long rows = n - start < POLYNOMIAL_ROWS ? n - start : POLYNOMIAL_ROWS;
+        for (long r = 0; r < rows; r++)
+        {
+            double t = (x[start + r] - center) / scale, power = 1.0;
+            for (int k = 0; k < degree; k++)
+            {
+                power *= t;
+                powers[r * degree + k] = power;
+            }
+        }
+        status = least_squares_append(&ls, powers, y + start, rows);
+    }
+    if (status == 0)
+        status = least_squares_solve(&ls, c + 1, &c[0], r2);
+
+    // Expand sum c_k ((x - center) / scale)^k into powers of x (Horner with a shifted linear factor)
+    if (status == 0)
+    {
+        for (int k = 0; k <= degree; k++)
+            coef[k] = 0.0;
+        for (int k = degree; k >= 0; k--)
+        {
+            // coef = coef * (x - center) / scale + c_k
+            for (int j = degree; j >= 1; j--)
+                coef[j] = (coef[j - 1] - center * coef[j]) / scale;
+            coef[0] = -center * coef[0] / scale + c[k];
+        }
+    }
+
+    least_squares_free(&ls);
+    free(powers);
+    free(c);
+    return status;
+}
+
+#endif
@@ -0,0 +1,316 @@
+// Levenberg-Marquardt nonlinear least squares
+// The EXPONENTIAL and POWER fits of 01-regression-analysis.c minimize the error of ln y,
+// which weights small y heavily, biases a, and rejects every y <= 0. Levenberg-Marquardt
+// minimizes sum (y_i - f(x_i; p))^2 in y itself: each iteration solves
+//     (J^T J + lambda diag(J^T J)) delta = J^T r
+// for the step, lowering lambda after a successful step (towards Gauss-Newton) and raising
+// it after a failed one (towards gradient descent).
+//     LMModel                   f with an analytic gradient, or written once with the dual_*
+//                               functions of dual.h for automatic derivatives
+//     levenberg_marquardt()     fit any LMModel from a starting point
+//     lm_fit()                  EXPONENTIAL (a exp(bx)) or POWER (a x^b), warm-started
+//                               from the log-linear estimate over the points with y > 0
+// J^T J, J^T r and the sum of squares are assembled in one pass over the data, one
+// contiguous range per thread, with the partials added in thread order. Returns 0 when
+// converged, 1 if LM_MAX_ITERATIONS was reached and -1 on invalid input or a singular system.
+//
+// Header only: include it with #include "../common/levenberg_marquardt.h", compile with
+// -fopenmp for threads and link with -lm.
+#ifndef LEVENBERG_MARQUARDT_H
+#define LEVENBERG_MARQUARDT_H
+
+#include <stdlib.h>
+#include <math.h>
+#include "dual.h"
+#include "regression_model.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define LM_MAX_PARAMS 8
+#define LM_MAX_ITERATIONS 200
+#define LM_TOLERANCE 1e-12 // Relative decrease of the sum of squares (or step) treated as converged
+
+// f(x; p) with its gradient with respect to p
+typedef double (*lm_analytic_function)(double x, const double params[], double gradient[]);
+
+// f(x; p) written with the dual_* functions; called once per parameter, seeded on that parameter
+typedef Dual (*lm_dual_function)(double x, const Dual params[]);
+
+// A model with p parameters; set analytic, or dual for automatic derivatives
+typedef struct
+{
+    int p;
+    lm_analytic_function analytic;
+    lm_dual_function dual;
+} LMModel;
+
+// Result of a fit
+typedef struct
+{
+    double sse;       // Sum of squared residuals
+    double rmse;      // sqrt(sse / n)
+    int iterations;   // Steps tried (accepted or not)
+    long evaluations; // Passes over the data
+} LMResult;
+
+// f(x; p) and its gradient
+static inline double lm_evaluate(const LMModel *model, double x, const double params[], double gradient[])
+{
+    if (model->analytic)
+        return model->analytic(x, params, gradient);
+
+    Dual seeded[LM_MAX_PARAMS], f = {0.0, 0.0};
+    for (int k = 0; k < model->p; k++)
+    {
+        for (int j = 0; j < model->p; j++)
+            seeded[j] = j == k ? dual_var(params[j]) : dual_const(params[j]);
+        f = model->dual(x, seeded);
+        gradient[k] = f.der;
+    }
+    return f.val;
+}
+
+// Sum of squares of the rows first <= i < last; with jtj non-NULL also J^T J (upper
+// triangle, p x p) and J^T r
+static double lm_range(const LMModel *model, const double *x, const double *y, long first, long last,
+                       const double params[], double jtj[], double jtr[])
+{
+    double gradient[LM_MAX_PARAMS], sse = 0.0;
+    int p = model->p;
+
+    for (long i = first; i < last; i++)
+    {
+        double r = y[i] - lm_evaluate(model, x[i], params, gradient);
+        sse += r * r;
+        if (!jtj)
+            continue;
+        for (int j = 0; j < p; j++)
+        {
+            jtr[j] += gradient[j] * r;
+            for (int k = j; k < p; k++)
+                jtj[j * p + k] += gradient[j] * gradient[k];
+        }
+    }
+    return sse;
+}
+
+// One pass over the data, one contiguous range per thread
+static double lm_assemble(const LMModel *model, const double *x, const double *y, long n, const double params[],
+                          double jtj[], double jtr[])
+{
+    int p = model->p;
+    double sse = 0.0;
+
+    if (jtj)
+    {
+        for (int j = 0; j < p * p; j++)
+            jtj[j] = 0.0;
+        for (int j = 0; j < p; j++)
+            jtr[j] = 0.0;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (n > 4096)
+    {
+        int threads = omp_get_num_threads(), t = omp_get_thread_num();
+        double partial_jtj[LM_MAX_PARAMS * LM_MAX_PARAMS] = {0.0}, partial_jtr[LM_MAX_PARAMS] = {0.0};
+        double partial = lm_range(model, x, y, n * t / threads, n * (t + 1) / threads, params,
+                                  jtj ? partial_jtj : NULL, partial_jtr);
+
+        // Add the partials in thread order so the result does not depend on timing
+#pragma omp for ordered schedule(static, 1)
+        for (int k = 0; k < threads; k++)
+        {
+#pragma omp ordered
+            {
+                sse += partial;
+                if (jtj)
+                {
+                    for (int j = 0; j < p * p; j++)
+                        jtj[j] += partial_jtj[j];
+                    for (int j = 0; j < p; j++)
+                        jtr[j] += partial_jtr[j];
+                }
+            }
+        }
+    }
+#else
+    sse = lm_range(model, x, y, 0, n, params, jtj, jtr);
+#endif
+    return sse;
+}
+
+// Solve the p x p system A delta = b (A symmetric positive definite, upper triangle given)
+// by Cholesky; returns 0 or -1 when A is not positive definite
+static int lm_solve(int p, const double A[], const double b[], double delta[])
+{
+    double L[LM_MAX_PARAMS * LM_MAX_PARAMS];
+
+    for (int j = 0; j < p; j++)
+    {
+        double d = A[j * p + j];
+        for (int k = 0; k < j; k++)
+            d -= L[j * p + k] * L[j * p + k];
+        if (!(d > 0.0))
+            return -1;
+        L[j * p + j] = sqrt(d);
+        for (int i = j + 1; i < p; i++)
+        {
+            double s = A[j * p + i];
+            for (int k = 0; k < j; k++)
+                s -= L[i * p + k] * L[j * p + k];
+            L[i * p + j] = s / L[j * p + j];
+        }
+    }
+    for (int i = 0; i < p; i++)
+    {
+        double s = b[i];
+        for (int k = 0; k < i; k++)
+            s -= L[i * p + k] * delta[k];
+        delta[i] = s / L[i * p + i];
+    }
+    for (int i = p - 1; i >= 0; i--)
+    {
+        double s = delta[i];
+        for (int k = i + 1; k < p; k++)
+            s -= L[k * p + i] * delta[k];
+        delta[i] = s / L[i * p + i];
+    }
+    return 0;
+}
+
+// Fit model to n points starting from params (updated in place)
+static inline int levenberg_marquardt(const LMModel *model, const double *x, const double *y, long n, double params[],
+                                      LMResult *result)
+{
+    int p = model->p;
+    double jtj[LM_MAX_PARAMS * LM_MAX_PARAMS], jtr[LM_MAX_PARAMS], A[LM_MAX_PARAMS * LM_MAX_PARAMS];
+    double delta[LM_MAX_PARAMS], trial[LM_MAX_PARAMS], lambda = 1e-3;
+
+    *result = (LMResult){0};
+    if (p < 1 || p > LM_MAX_PARAMS || (!model->analytic && !model->dual) || n < p)
+        return -1;
+
+    double sse = lm_assemble(model, x, y, n, params, jtj, jtr);
+    result->evaluations = 1;
+    int status = 1;
+
+    while (result->iterations < LM_MAX_ITERATIONS)
+    {
+        result->iterations++;
+        for (int j = 0; j < p * p; j++)
+            A[j] = jtj[j];
+        for (int j = 0; j < p; j++)
+            A[j * p + j] += lambda * (jtj[j * p + j] > 0.0 ? jtj[j * p + j] : 1.0);
+        if (lm_solve(p, A, jtr, delta) != 0)
+        {
+            lambda *= 10;
+            continue;
+        }
+
+        double step = 0.0, size = 0.0;
+        for (int j = 0; j < p; j++)
+        {
+            trial[j] = params[j] + delta[j];
+            step += delta[j] * delta[j];
+            size += params[j] * params[j];
+        }
+        double trial_sse = lm_assemble(model, x, y, n, trial, NULL, NULL);
+        result->evaluations++;
+
+        if (isfinite(trial_sse) && trial_sse <= sse)
+        {
+            double decrease = sse - trial_sse;
+            for (int j = 0; j < p; j++)
+                params[j] = trial[j];
+            sse = trial_sse;
+            lambda = fmax(lambda / 10, 1e-12);
+            if (decrease <= LM_TOLERANCE * sse || step <= LM_TOLERANCE * LM_TOLERANCE * size)
+            {
+                status = 0;
+                break;
+            }
+            sse = lm_assemble(model, x, y, n, params, jtj, jtr);
+            result->evaluations++;
+        }
+        else
+        {
+            lambda *= 10;
+            if (lambda > 1e16)
+            {
+                status = 0; // No step decreases the sum of squares: at a minimum to working precision
+                break;
+            }
+        }
+    }
+
+    result->sse = sse;
+    result->rmse = sqrt(sse / n);
+    return status;
+}
+
+// a exp(bx)
+static double lm_exponential(double x, const double params[], double gradient[])
+{
+    double e = exp(params[1] * x);
+    gradient[0] = e;
+    gradient[1] = params[0] * x * e;
+    return params[0] * e;
+}
+
+// a x^b (x > 0)
+static double lm_power(double x, const double params[], double gradient[])
+{
+    double e = pow(x, params[1]);
+    gradient[0] = e;
+    gradient[1] = params[0] * e * log(x);
+    return params[0] * e;
+}
+
+// Fit EXPONENTIAL or POWER to n points in y itself. y may be zero or negative; POWER needs
+// x > 0. The log-linear fit of the points with y > 0 gives the starting point. The fitted
+// model has a in model->a (intercept = ln a when a > 0, NAN otherwise).
+static inline int lm_fit(RegressionType type, const double *x, const double *y, long n, RegressionModel *model,
+                         LMResult *result)
+{
+    LMModel lm = {2, type == EXPONENTIAL ? lm_exponential : lm_power, NULL};
+    RegressionMoments moments = {0};
+    double params[2], slope, intercept;
+
+    *result = (LMResult){0};
+    if (type != EXPONENTIAL && type != POWER)
+        return -1;
+    for (long i = 0; i < n; i++)
+    {
+        if (type == POWER && x[i] <= 0)
+            return -1;
+        if (y[i] > 0)
+            moments_add(&moments, type == POWER ? log(x[i]) : x[i], log(y[i]));
+    }
+
+    // Warm start; without enough positive y, start from a = mean |y|, b = 0
+    if (regression_moments_fit(&moments, &slope, &intercept) == 0)
+    {
+        params[0] = exp(intercept);
+        params[1] = slope;
+    }
+    else
+    {
+        params[0] = 0.0;
+        for (long i = 0; i < n; i++)
+            params[0] += fabs(y[i]) / n;
+        params[1] = 0.0;
+    }
+
+    int status = levenberg_marquardt(&lm, x, y, n, params, result);
+    if (status >= 0)
+    {
+        *model = regression_model(type, params[1], params[0] > 0 ? log(params[0]) : NAN);
+        model->a = params[0];
+    }
+    return status;
+}
+
+#endif
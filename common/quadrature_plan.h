@@ -0,0 +1,162 @@
+// Reusable quadrature plans
+// Like an FFTW plan, a QuadraturePlan does all the setup for a rule and a number of points
+// once: abscissae on the reference interval [0, 1], weights, and scratch space. Every
+// execution afterwards is a single weighted sum, with no allocation, no recomputation of h
+// or of the weight pattern, and no Romberg tableau:
+//     quadrature_plan_init()        build the plan (the only allocation)
+//     quadrature_execute()          integrate f over [a, b] (any a and b)
+//     quadrature_execute_batch()    same with a batch integrand, using the plan's scratch
+//     quadrature_plan_free()
+// Romberg's result is a fixed linear combination of the function values on the finest grid,
+// so its weights are found once by pushing each trapezoid estimate through the extrapolation.
+// A plan can be shared by threads with quadrature_execute(); quadrature_execute_batch()
+// writes to the scratch buffers, so give each thread its own plan.
+//
+// Header only: include it with #include "../common/quadrature_plan.h" and link with -lm.
+#ifndef QUADRATURE_PLAN_H
+#define QUADRATURE_PLAN_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "gauss_legendre.h"
+
+typedef enum
+{
+    PLAN_TRAPEZOIDAL = 1,
+    PLAN_SIMPSON_13,
+    PLAN_SIMPSON_38,
+    PLAN_ROMBERG,       // n levels: 2^(n - 1) + 1 points
+    PLAN_GAUSS_LEGENDRE // n points
+} PlanRule;
+
+typedef struct
+{
+    PlanRule rule;
+    int n;      // Subintervals (composite rules), levels (Romberg) or points (Gauss)
+    int points; // Number of abscissae
+    double *t;  // Abscissae on [0, 1]
+    double *w;  // Weights on [0, 1] (multiply by b - a)
+    double *x;  // Scratch: abscissae on [a, b]
+    double *fx; // Scratch: function values
+} QuadraturePlan;
+
+// Build a plan; returns 0, or -1 on invalid arguments or allocation failure
+static inline int quadrature_plan_init(QuadraturePlan *p, PlanRule rule, int n)
+{
+    memset(p, 0, sizeof(*p));
+    if (rule == PLAN_SIMPSON_13 && n % 2 != 0)
+        n++; // n must be even for Simpson's rule
+    if (rule == PLAN_SIMPSON_38 && n % 3 != 0)
+        n += 3 - (n % 3); // n must be a multiple of 3 for Simpson's 3/8 rule
+    if (n < 1 || (rule == PLAN_ROMBERG && n > 30))
+        return -1;
+
+    int points = rule == PLAN_ROMBERG ? (1 << (n - 1)) + 1 : rule == PLAN_GAUSS_LEGENDRE ? n : n + 1;
+    double *memory = calloc(4 * (size_t)points, sizeof(double));
+    if (!memory)
+        return -1;
+
+    p->rule = rule;
+    p->n = n;
+    p->points = points;
+    p->t = memory;
+    p->w = memory + points;
+    p->x = memory + 2 * points;
+    p->fx = memory + 3 * points;
+
+    if (rule == PLAN_GAUSS_LEGENDRE)
+    {
+        const GaussRule *g = gauss_rule(GAUSS_LEGENDRE, n);
+        if (!g)
+        {
+            free(memory);
+            return -1;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            p->t[i] = 0.5 * (1.0 + g->x[i]);
+            p->w[i] = 0.5 * g->w[i];
+        }
+        return 0;
+    }
+
+    int subintervals = points - 1;
+    for (int i = 0; i <= subintervals; i++)
+        p->t[i] = (double)i / subintervals;
+
+    if (rule == PLAN_ROMBERG)
+    {
+        // R[n-1][n-1] = sum c_k T_k; c_k is the extrapolation of the unit vector e_k
+        for (int k = 0; k < n; k++)
+        {
+            double previous[32], current[32];
+            for (int i = 0; i < n; i++)
+            {
+                current[0] = i == k;
+                double factor = 1.0;
+                for (int j = 1; j <= i; j++)
+                {
+                    factor *= 4.0;
+                    current[j] = current[j - 1] + (current[j - 1] - previous[j - 1]) / (factor - 1.0);
+                }
+                memcpy(previous, current, (i + 1) * sizeof(double));
+            }
+
+            // Add c_k times the weights of the trapezoid with 2^k subintervals
+            int stride = 1 << (n - 1 - k), count = 1 << k;
+            for (int i = 0; i <= count; i++)
+                p->w[i * stride] += previous[n - 1] * (i == 0 || i == count ? 0.5 : 1.0) / count;
+        }
+        return 0;
+    }
+
+    double h = 1.0 / n;
+    for (int i = 0; i <= n; i++)
+    {
+        if (rule == PLAN_TRAPEZOIDAL)
+            p->w[i] = h;
+        else if (rule == PLAN_SIMPSON_13)
+            p->w[i] = (i % 2 == 0 ? 2 : 4) * h / 3;
+        else
+            p->w[i] = (i % 3 == 0 ? 2 : 3) * h * 3 / 8;
+    }
+    p->w[0] = p->w[n] = rule == PLAN_TRAPEZOIDAL ? h / 2 : rule == PLAN_SIMPSON_13 ? h / 3 : h * 3 / 8;
+    return 0;
+}
+
+static inline void quadrature_plan_free(QuadraturePlan *p)
+{
+    free(p->t);
+    memset(p, 0, sizeof(*p));
+}
+
+// Integral of f over [a, b]
+static inline double quadrature_execute(const QuadraturePlan *p, double (*f)(double), double a, double b)
+{
+    double sum = 0.0, length = b - a;
+    for (int i = 0; i < p->points; i++)
+        sum += p->w[i] * f(a + length * p->t[i]);
+    return sum * length;
+}
+
+// Integral of a batch integrand over [a, b]; uses the plan's scratch buffers
+static inline double quadrature_execute_batch(QuadraturePlan *p, gauss_batch_function f, double a, double b)
+{
+    double sum = 0.0, length = b - a;
+    int n = p->points;
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (int i = 0; i < n; i++)
+        p->x[i] = a + length * p->t[i];
+    f(p->x, p->fx, n);
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+    for (int i = 0; i < n; i++)
+        sum += p->w[i] * p->fx[i];
+    return sum * length;
+}
+
+#endif
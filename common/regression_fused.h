@@ -0,0 +1,269 @@
+// Fused regression: all four models in one pass, with goodness of fit
+// The models of regression_stream.h only need ln x and ln y besides x and y, so one scan
+// computes each log once and accumulates the moments of all four transformed data sets:
+//     LINEAR (x, y)   EXPONENTIAL (x, ln y)   LOGARITHMIC (ln x, y)   POWER (ln x, ln y)
+// The logs are taken in a simd loop over a block of REGRESSION_BLOCK rows; with -ffast-math
+// gcc calls the vector log of glibc (libmvec). Goodness of fit follows from the moments alone:
+//     SSE = Syy - Sxy^2 / Sxx,  R^2 = 1 - SSE / Syy,  RMSE = sqrt(SSE / n)
+// plus the residual standard error and the standard errors of the slope and intercept.
+// All of them are measured in the coordinates the model is fitted in (ln y for EXPONENTIAL
+// and POWER), which is what the log-linear least-squares fit minimizes, so their R^2 values
+// cannot rank models against each other. Once the coefficients are known, a second pass
+// measures every model in y itself.
+//     regression_fused_add()      m interleaved (x, y) pairs into moments[4], split across threads
+//     regression_goodness()       coefficients and statistics of one model from its moments
+//     regression_fit_all()        both steps for an array in memory
+//     regression_original_scale() SSE and R^2 of the fitted models in y (second pass)
+//
+// Header only: include it with #include "../common/regression_fused.h", compile with
+// -fopenmp for threads (and -ffast-math for the vector log) and link with -lm.
+#ifndef REGRESSION_FUSED_H
+#define REGRESSION_FUSED_H
+
+#include <math.h>
+#include "regression_stream.h"
+
+// Fitted model with goodness of fit
+typedef struct
+{
+    RegressionType type;
+    int fitted;              // 0 when rows were rejected or fewer than two distinct X were seen
+    long n, invalid;         // Rows used and rows rejected by the transform
+    double slope, intercept; // As slope_m and intercept_c of 01 (intercept is ln a for EXPONENTIAL and POWER)
+    double r2, rmse, sse;
+    double residual_se;      // sqrt(SSE / (n - 2))
+    double slope_se, intercept_se;
+    double original_sse, original_r2; // In y itself, from regression_original_scale() (NAN until then)
+} RegressionFit;
+
+// Moments of the four models for count <= REGRESSION_BLOCK interleaved rows
+static void fused_block(RegressionMoments moments[4], const double *xy, int count)
+{
+    double lx[REGRESSION_BLOCK], ly[REGRESSION_BLOCK], vx[REGRESSION_BLOCK], vy[REGRESSION_BLOCK];
+    double n_x = 0.0, n_y = 0.0, n_xy = 0.0;
+    double sx = 0.0, sy = 0.0, sx_vy = 0.0, sly = 0.0, slx = 0.0, sy_vx = 0.0, slx_vy = 0.0, sly_vx = 0.0;
+
+    // Pass 1: logs (each computed once), validity and the sums for the means
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : n_x, n_y, n_xy, sx, sy, sx_vy, sly, slx, sy_vx, slx_vy, sly_vx)
+#endif
+    for (int i = 0; i < count; i++)
+    {
+        double x = xy[2 * i], y = xy[2 * i + 1];
+        vx[i] = x > 0;
+        vy[i] = y > 0;
+        lx[i] = log(x > 0 ? x : 1.0); // 0 for rejected rows
+        ly[i] = log(y > 0 ? y : 1.0);
+        n_x += vx[i];
+        n_y += vy[i];
+        n_xy += vx[i] * vy[i];
+        sx += x;
+        sy += y;
+        sx_vy += vy[i] * x;
+        sly += ly[i];
+        slx += lx[i];
+        sy_vx += vx[i] * y;
+        slx_vy += vy[i] * lx[i];
+        sly_vx += vx[i] * ly[i];
+    }
+
+    // Means of X and Y for each model (index type - 1)
+    double n[4] = {count, n_y, n_x, n_xy};
+    double mx[4] = {sx / count, n_y > 0 ? sx_vy / n_y : 0.0, n_x > 0 ? slx / n_x : 0.0, n_xy > 0 ? slx_vy / n_xy : 0.0};
+    double my[4] = {sy / count, n_y > 0 ? sly / n_y : 0.0, n_x > 0 ? sy_vx / n_x : 0.0, n_xy > 0 ? sly_vx / n_xy : 0.0};
+    double sxx0 = 0.0, syy0 = 0.0, sxy0 = 0.0, sxx1 = 0.0, syy1 = 0.0, sxy1 = 0.0;
+    double sxx2 = 0.0, syy2 = 0.0, sxy2 = 0.0, sxx3 = 0.0, syy3 = 0.0, sxy3 = 0.0;
+
+    // Pass 2: centred sums over the block (still in cache)
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sxx0, syy0, sxy0, sxx1, syy1, sxy1, sxx2, syy2, sxy2, sxx3, syy3, sxy3)
+#endif
+    for (int i = 0; i < count; i++)
+    {
+        double x = xy[2 * i], y = xy[2 * i + 1], v = vx[i] * vy[i];
+        double dx0 = x - mx[0], dy0 = y - my[0];
+        double dx1 = vy[i] * (x - mx[1]), dy1 = vy[i] * (ly[i] - my[1]);
+        double dx2 = vx[i] * (lx[i] - mx[2]), dy2 = vx[i] * (y - my[2]);
+        double dx3 = v * (lx[i] - mx[3]), dy3 = v * (ly[i] - my[3]);
+        sxx0 += dx0 * dx0;
+        syy0 += dy0 * dy0;
+        sxy0 += dx0 * dy0;
+        sxx1 += dx1 * dx1;
+        syy1 += dy1 * dy1;
+        sxy1 += dx1 * dy1;
+        sxx2 += dx2 * dx2;
+        syy2 += dy2 * dy2;
+        sxy2 += dx2 * dy2;
+        sxx3 += dx3 * dx3;
+        syy3 += dy3 * dy3;
+        sxy3 += dx3 * dy3;
+    }
+    double s[4][3] = {{sxx0, syy0, sxy0}, {sxx1, syy1, sxy1}, {sxx2, syy2, sxy2}, {sxx3, syy3, sxy3}};
+
+    for (int k = 0; k < 4; k++)
+    {
+        RegressionMoments block = {0};
+        block.invalid = count - (long)n[k];
+        if (n[k] > 0)
+        {
+            block.n = (long)n[k];
+            block.mean_x = mx[k];
+            block.mean_y = my[k];
+            block.sxx = s[k][0];
+            block.syy = s[k][1];
+            block.sxy = s[k][2];
+        }
+        moments_merge(&moments[k], &block);
+    }
+}
+
+// Moments of the rows first <= i < last
+static void fused_range(RegressionMoments moments[4], const double *xy, long first, long last)
+{
+    for (long start = first; start < last; start += REGRESSION_BLOCK)
+    {
+        long end = start + REGRESSION_BLOCK < last ? start + REGRESSION_BLOCK : last;
+        fused_block(moments, xy + 2 * start, (int)(end - start));
+    }
+}
+
+// Add m interleaved pairs to the moments of all four models (moments[type - 1]),
+// one contiguous range per thread
+static inline void regression_fused_add(RegressionMoments moments[4], const double *xy, long m)
+{
+#ifdef _OPENMP
+#pragma omp parallel if (m > 16 * REGRESSION_BLOCK)
+    {
+        int threads = omp_get_num_threads(), t = omp_get_thread_num();
+        RegressionMoments partial[4] = {{0}};
+        fused_range(partial, xy, m * t / threads, m * (t + 1) / threads);
+
+        // Merge the partials in thread order so the result does not depend on timing
+#pragma omp for ordered schedule(static, 1)
+        for (int k = 0; k < threads; k++)
+        {
+#pragma omp ordered
+            for (int j = 0; j < 4; j++)
+                moments_merge(&moments[j], &partial[j]);
+        }
+    }
+#else
+    fused_range(moments, xy, 0, m);
+#endif
+}
+
+// Coefficients and goodness of fit of one model; returns 0, or -1 if it cannot be fitted
+static inline int regression_goodness(const RegressionMoments *m, RegressionType type, RegressionFit *fit)
+{
+    *fit = (RegressionFit){0};
+    fit->type = type;
+    fit->original_sse = fit->original_r2 = NAN;
+    fit->n = m->n;
+    fit->invalid = m->invalid;
+    if (m->invalid > 0 || regression_moments_fit(m, &fit->slope, &fit->intercept) != 0)
+        return -1;
+
+    fit->fitted = 1;
+    fit->sse = fmax(m->syy - m->sxy * m->sxy / m->sxx, 0.0);
+    fit->r2 = m->syy > 0.0 ? 1.0 - fit->sse / m->syy : 1.0;
+    fit->rmse = sqrt(fit->sse / m->n);
+    if (m->n > 2)
+    {
+        fit->residual_se = sqrt(fit->sse / (m->n - 2));
+        fit->slope_se = fit->residual_se / sqrt(m->sxx);
+        fit->intercept_se = fit->residual_se * sqrt(1.0 / m->n + m->mean_x * m->mean_x / m->sxx);
+    }
+    return 0;
+}
+
+// Fit all four models to n interleaved pairs in one pass (fits[type - 1]); returns the
+// number of models that could be fitted
+static inline int regression_fit_all(const double *xy, long n, RegressionFit fits[4])
+{
+    RegressionMoments moments[4] = {{0}};
+    int fitted = 0;
+
+    regression_fused_add(moments, xy, n);
+    for (int k = 0; k < 4; k++)
+        fitted += regression_goodness(&moments[k], (RegressionType)(k + 1), &fits[k]) == 0;
+    return fitted;
+}
+
+// Prediction of a fitted model in y
+static double fused_predict(const RegressionFit *fit, double x)
+{
+    switch (fit->type)
+    {
+    case EXPONENTIAL:
+        return exp(fit->intercept + fit->slope * x);
+    case LOGARITHMIC:
+        return fit->intercept + fit->slope * log(x);
+    case POWER:
+        return exp(fit->intercept + fit->slope * log(x));
+    default:
+        return fit->slope * x + fit->intercept;
+    }
+}
+
+// Squared errors in y of the fitted models over the rows first <= i < last (sums[type - 1]),
+// with the sums of y - shift and its square in sums[4] and sums[5]
+static void fused_original_range(const RegressionFit fits[4], const double *xy, long first, long last, double shift,
+                                 double sums[6])
+{
+    for (long i = first; i < last; i++)
+    {
+        double x = xy[2 * i], y = xy[2 * i + 1], d = y - shift;
+        for (int k = 0; k < 4; k++)
+        {
+            if (fits[k].fitted)
+            {
+                double r = y - fused_predict(&fits[k], x);
+                sums[k] += r * r;
+            }
+        }
+        sums[4] += d;
+        sums[5] += d * d;
+    }
+}
+
+// Fill original_sse and original_r2 of the fitted models from a second pass over the n
+// pairs they were fitted to, so that models can be compared on the same scale
+static inline void regression_original_scale(const double *xy, long n, RegressionFit fits[4])
+{
+    double sums[6] = {0.0};
+    if (n < 1)
+        return;
+
+    // Shifting y by its first value keeps the total sum of squares free of cancellation
+    double shift = xy[1];
+#ifdef _OPENMP
+#pragma omp parallel if (n > 16 * REGRESSION_BLOCK)
+    {
+        int threads = omp_get_num_threads(), t = omp_get_thread_num();
+        double partial[6] = {0.0};
+        fused_original_range(fits, xy, n * t / threads, n * (t + 1) / threads, shift, partial);
+
+        // Add the partials in thread order so the result does not depend on timing
+#pragma omp for ordered schedule(static, 1)
+        for (int k = 0; k < threads; k++)
+        {
+#pragma omp ordered
+            for (int j = 0; j < 6; j++)
+                sums[j] += partial[j];
+        }
+    }
+#else
+    fused_original_range(fits, xy, 0, n, shift, sums);
+#endif
+
+    double total = fmax(sums[5] - sums[4] * sums[4] / n, 0.0);
+    for (int k = 0; k < 4; k++)
+    {
+        if (!fits[k].fitted)
+            continue;
+        fits[k].original_sse = sums[k];
+        fits[k].original_r2 = total > 0.0 ? 1.0 - sums[k] / total : 1.0;
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Reentrant regression models
+// 01-regression-analysis.c keeps the fitted coefficients in the globals slope_m and
+// intercept_c, so only one model can exist at a time and nothing may fit or predict
+// concurrently. A RegressionModel is a plain value holding everything a prediction needs,
+// including the derived constant a = exp(intercept) of the exponential and power models,
+// which regression_predict() of 01 recomputes on every call:
+//     regression_model_fit()      fit a model to n points (reentrant, no globals)
+//     regression_model_predict()  one prediction
+//     predict_batch()             n predictions; the model type is resolved once, the loop
+//                                 is a simd loop (vector exp/log/pow from glibc's libmvec
+//                                 with -ffast-math) and large batches are split across threads
+// Predictions at x <= 0 for the logarithmic and power models are NAN.
+//
+// Header only: include it with #include "../common/regression_model.h", compile with
+// -fopenmp for threads and simd, and link with -lm.
+#ifndef REGRESSION_MODEL_H
+#define REGRESSION_MODEL_H
+
+#include <math.h>
+#include "regression_stream.h"
+
+#define PREDICT_PARALLEL 65536 // Smallest batch split across threads
+
+// A fitted model
+typedef struct
+{
+    RegressionType type;
+    double slope;     // m (LINEAR) or b
+    double intercept; // c (LINEAR), ln a (EXPONENTIAL, POWER) or a (LOGARITHMIC)
+    double a;         // exp(intercept) for EXPONENTIAL and POWER, intercept otherwise
+} RegressionModel;
+
+// Model from its coefficients in the form of slope_m and intercept_c of 01
+static inline RegressionModel regression_model(RegressionType type, double slope, double intercept)
+{
+    RegressionModel model = {type, slope, intercept, intercept};
+    if (type == EXPONENTIAL || type == POWER)
+        model.a = exp(intercept);
+    return model;
+}
+
+// Fit a model to n points; returns 0, or -1 when a log cannot be taken or all x are equal
+static inline int regression_model_fit(const double *x, const double *y, long n, RegressionType type,
+                                       RegressionModel *model)
+{
+    RegressionMoments moments = {0};
+    double slope, intercept;
+    int log_x = type == LOGARITHMIC || type == POWER;
+    int log_y = type == EXPONENTIAL || type == POWER;
+
+    if (type < LINEAR || type > POWER)
+        return -1;
+    for (long i = 0; i < n; i++)
+    {
+        if ((log_x && x[i] <= 0) || (log_y && y[i] <= 0))
+            return -1;
+        moments_add(&moments, log_x ? log(x[i]) : x[i], log_y ? log(y[i]) : y[i]);
+    }
+    if (regression_moments_fit(&moments, &slope, &intercept) != 0)
+        return -1;
+    *model = regression_model(type, slope, intercept);
+    return 0;
+}
+
+// Prediction at x
+static inline double regression_model_predict(const RegressionModel *model, double x)
+{
+    switch (model->type)
+    {
+    case LINEAR:
+        return model->slope * x + model->intercept;
+    case EXPONENTIAL:
+        return model->a * exp(model->slope * x);
+    case LOGARITHMIC:
+        return x > 0 ? model->a + model->slope * log(x) : NAN;
+    case POWER:
+        return x > 0 ? model->a * pow(x, model->slope) : NAN;
+    default:
+        return NAN;
+    }
+}
+
+// y[i] = prediction at x[i] for 0 <= i < n
+static inline void predict_batch(const RegressionModel *model, const double *x, double *y, long n)
+{
+    const double a = model->a, b = model->slope, c = model->intercept;
+
+    switch (model->type)
+    {
+    case LINEAR:
+#ifdef _OPENMP
+#pragma omp parallel for simd if (n >= PREDICT_PARALLEL) schedule(static)
+#endif
+        for (long i = 0; i < n; i++)
+            y[i] = b * x[i] + c;
+        break;
+    case EXPONENTIAL:
+#ifdef _OPENMP
+#pragma omp parallel for simd if (n >= PREDICT_PARALLEL) schedule(static)
+#endif
+        for (long i = 0; i < n; i++)
+            y[i] = a * exp(b * x[i]);
+        break;
+    case LOGARITHMIC:
+#ifdef _OPENMP
+#pragma omp parallel for simd if (n >= PREDICT_PARALLEL) schedule(static)
+#endif
+        for (long i = 0; i < n; i++)
+            y[i] = x[i] > 0 ? a + b * log(x[i] > 0 ? x[i] : 1.0) : NAN;
+        break;
+    case POWER:
+#ifdef _OPENMP
+#pragma omp parallel for simd if (n >= PREDICT_PARALLEL) schedule(static)
+#endif
+        for (long i = 0; i < n; i++)
+            y[i] = x[i] > 0 ? a * pow(x[i] > 0 ? x[i] : 1.0, b) : NAN;
+        break;
+    default:
+        for (long i = 0; i < n; i++)
+            y[i] = NAN;
+        break;
+    }
+}
+
+#endif
@@ -0,0 +1,179 @@
+// Streaming least-squares regression
+// The four models of 05-regression-analysis/01-regression-analysis.c are straight lines in
+// transformed coordinates (X, Y):
+//     LINEAR       y = m x + c          X = x      Y = y
+//     EXPONENTIAL  y = a exp(bx)        X = x      Y = ln y
+//     LOGARITHMIC  y = a + b ln x       X = ln x   Y = y
+//     POWER        y = a x^b            X = ln x   Y = ln y
+// Instead of the raw sums (n Sxy - Sx Sy), which cancel catastrophically for large n or data
+// far from the origin, the fit keeps the count, the means and the centred sums of squares
+// and cross products. These moments are updated point by point (Welford) or block by block,
+// and two sets of moments merge exactly (Chan et al.), so a file of any length is read once,
+// each thread accumulates its own rows and the partial states are merged at the end.
+//     moments_add()            one point
+//     moments_merge()          combine two partial states
+//     regression_stream_add()  m interleaved (x, y) pairs, split across threads
+//     regression_moments_fit() slope and intercept (as slope_m and intercept_c of 01)
+// Rows a model cannot take the log of are counted in `invalid` and left out of the sums.
+//
+// Header only: include it with #include "../common/regression_stream.h", compile with
+// -fopenmp for threads and link with -lm.
+#ifndef REGRESSION_STREAM_H
+#define REGRESSION_STREAM_H
+
+#include <math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define REGRESSION_BLOCK 1024 // Rows transformed and reduced together
+
+// Regression models (as in 01-regression-analysis.c)
+typedef enum
+{
+    LINEAR = 1,
+    EXPONENTIAL, // y = a * exp(bx)
+    LOGARITHMIC, // y = a + b*ln(x)
+    POWER        // y = a * x^b
+} RegressionType;
+
+// Mergeable moments of the transformed points
+typedef struct
+{
+    long n;                // Points in the sums
+    double mean_x, mean_y; // Means of X and Y
+    double sxx, syy, sxy;  // Centred sums: sum (X - mean_x)^2, (Y - mean_y)^2, (X - mean_x)(Y - mean_y)
+    long invalid;          // Rows rejected by the transform (x <= 0 or y <= 0 where a log is taken)
+} RegressionMoments;
+
+// Add one transformed point (Welford)
+static inline void moments_add(RegressionMoments *m, double x, double y)
+{
+    double dx = x - m->mean_x, dy = y - m->mean_y;
+    m->n++;
+    m->mean_x += dx / m->n;
+    m->mean_y += dy / m->n;
+    m->sxx += dx * (x - m->mean_x);
+    m->syy += dy * (y - m->mean_y);
+    m->sxy += dx * (y - m->mean_y);
+}
+
+// Merge b into a
+static inline void moments_merge(RegressionMoments *a, const RegressionMoments *b)
+{
+    a->invalid += b->invalid;
+    if (b->n == 0)
+        return;
+    if (a->n == 0)
+    {
+        long invalid = a->invalid;
+        *a = *b;
+        a->invalid = invalid;
+        return;
+    }
+
+    double n = (double)a->n + b->n, w = (double)a->n * b->n / n;
+    double dx = b->mean_x - a->mean_x, dy = b->mean_y - a->mean_y;
+    a->mean_x += dx * b->n / n;
+    a->mean_y += dy * b->n / n;
+    a->sxx += b->sxx + dx * dx * w;
+    a->syy += b->syy + dy * dy * w;
+    a->sxy += b->sxy + dx * dy * w;
+    a->n += b->n;
+}
+
+// Moments of count <= REGRESSION_BLOCK interleaved rows, two-pass within the block
+static void moments_block(RegressionMoments *m, RegressionType type, const double *xy, int count)
+{
+    double X[REGRESSION_BLOCK], Y[REGRESSION_BLOCK], valid[REGRESSION_BLOCK];
+    int log_x = type == LOGARITHMIC || type == POWER;
+    int log_y = type == EXPONENTIAL || type == POWER;
+    double n = 0.0, sx = 0.0, sy = 0.0;
+
+    // Transform; rejected rows get weight 0 (and a harmless log argument)
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : n, sx, sy)
+#endif
+    for (int i = 0; i < count; i++)
+    {
+        double x = xy[2 * i], y = xy[2 * i + 1];
+        int ok = (!log_x || x > 0) && (!log_y || y > 0);
+        valid[i] = ok;
+        X[i] = log_x ? log(ok ? x : 1.0) : (ok ? x : 0.0);
+        Y[i] = log_y ? log(ok ? y : 1.0) : (ok ? y : 0.0);
+        n += valid[i];
+        sx += X[i];
+        sy += Y[i];
+    }
+
+    RegressionMoments block = {0};
+    block.invalid = count - (long)n;
+    if (n > 0)
+    {
+        double mx = sx / n, my = sy / n, sxx = 0.0, syy = 0.0, sxy = 0.0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sxx, syy, sxy)
+#endif
+        for (int i = 0; i < count; i++)
+        {
+            double dx = valid[i] * (X[i] - mx), dy = valid[i] * (Y[i] - my);
+            sxx += dx * dx;
+            syy += dy * dy;
+            sxy += dx * dy;
+        }
+        block.n = (long)n;
+        block.mean_x = mx;
+        block.mean_y = my;
+        block.sxx = sxx;
+        block.syy = syy;
+        block.sxy = sxy;
+    }
+    moments_merge(m, &block);
+}
+
+// Moments of the rows first <= i < last
+static void moments_range(RegressionMoments *m, RegressionType type, const double *xy, long first, long last)
+{
+    for (long start = first; start < last; start += REGRESSION_BLOCK)
+    {
+        long end = start + REGRESSION_BLOCK < last ? start + REGRESSION_BLOCK : last;
+        moments_block(m, type, xy + 2 * start, (int)(end - start));
+    }
+}
+
+// Add m interleaved pairs x0 y0 x1 y1 ... to the running moments, one contiguous range per thread
+static inline void regression_stream_add(RegressionMoments *moments, RegressionType type, const double *xy, long m)
+{
+#ifdef _OPENMP
+#pragma omp parallel if (m > 16 * REGRESSION_BLOCK)
+    {
+        int threads = omp_get_num_threads(), t = omp_get_thread_num();
+        RegressionMoments partial = {0};
+        moments_range(&partial, type, xy, m * t / threads, m * (t + 1) / threads);
+
+        // Merge the partials in thread order so the result does not depend on timing
+#pragma omp for ordered schedule(static, 1)
+        for (int k = 0; k < threads; k++)
+        {
+#pragma omp ordered
+            moments_merge(moments, &partial);
+        }
+    }
+#else
+    moments_range(moments, type, xy, 0, m);
+#endif
+}
+
+// Least-squares line Y = slope X + intercept; returns 0, or -1 with fewer than two points
+// or when all X are equal
+static inline int regression_moments_fit(const RegressionMoments *m, double *slope, double *intercept)
+{
+    if (m->n < 2 || m->sxx <= 0.0)
+        return -1;
+    *slope = m->sxy / m->sxx;
+    *intercept = m->mean_y - *slope * m->mean_x;
+    return 0;
+}
+
+#endif
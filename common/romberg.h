@@ -0,0 +1,113 @@
+// Incremental Romberg integration
+// Unlike romberg() in 06-rombergs-integration/01-rombergs-integration.c, which fills an n x n
+// tableau on the stack, the engine keeps only the previous and the current row, adds one
+// level at a time and stops once two successive diagonal entries agree:
+//     romberg_init()       trapezoid on [a, b] (level 0)
+//     romberg_refine()     halve the step: evaluate the new midpoints, extrapolate the row
+//     romberg_integrate()  refine until converged or max_levels; call again with a tighter
+//                          tolerance to resume from the saved state
+// The Richardson factors 4^j are built by repeated multiplication, and the midpoints of a
+// level are summed in parallel when compiled with -fopenmp (once a level has enough of them
+// to pay for starting the threads).
+//
+// Header only: include it with #include "../common/romberg.h" and link with -lm.
+#ifndef ROMBERG_H
+#define ROMBERG_H
+
+#include <math.h>
+
+#define ROMBERG_MAX_LEVELS 31 // 2^30 subintervals at the last level
+#define ROMBERG_MIN_LEVELS 4  // Levels computed before convergence is trusted
+#define ROMBERG_PARALLEL 4096 // Midpoints per level before the sum is split across threads
+
+// Saved state of a Romberg integration
+typedef struct
+{
+    double (*func)(double);
+    double a, b;
+    int level;                          // Last completed level (row index)
+    long evaluations;                   // Calls to func so far
+    double previous[ROMBERG_MAX_LEVELS]; // Row level - 1
+    double current[ROMBERG_MAX_LEVELS];  // Row level, current[level] is the best estimate
+} RombergState;
+
+// Start a new integration of func over [a, b]
+static inline void romberg_init(RombergState *s, double (*func)(double), double a, double b)
+{
+    s->func = func;
+    s->a = a;
+    s->b = b;
+    s->level = 0;
+    s->evaluations = 2;
+    s->current[0] = (func(a) + func(b)) * (b - a) / 2.0;
+}
+
+// Add one level. Returns 0, or -1 if ROMBERG_MAX_LEVELS is reached.
+static inline int romberg_refine(RombergState *s)
+{
+    if (s->level + 1 >= ROMBERG_MAX_LEVELS)
+        return -1;
+
+    int i = ++s->level;
+    long midpoints = 1L << (i - 1);
+    double step = (s->b - s->a) / (2 * midpoints);
+    double a = s->a, sum = 0.0;
+    double (*func)(double) = s->func;
+
+    // A parallel region costs microseconds even with one thread, so small levels stay serial
+#ifdef _OPENMP
+    if (midpoints >= ROMBERG_PARALLEL)
+    {
+#pragma omp parallel for reduction(+ : sum) schedule(static)
+        for (long k = 0; k < midpoints; k++)
+            sum += func(a + (2 * k + 1) * step);
+    }
+    else
+#endif
+        for (long k = 0; k < midpoints; k++)
+            sum += func(a + (2 * k + 1) * step);
+    s->evaluations += midpoints;
+
+    // The new row overwrites the older one
+    for (int j = 0; j < i; j++)
+        s->previous[j] = s->current[j];
+
+    s->current[0] = 0.5 * s->previous[0] + sum * step;
+    double factor = 1.0;
+    for (int j = 1; j <= i; j++)
+    {
+        factor *= 4.0;
+        s->current[j] = s->current[j - 1] + (s->current[j - 1] - s->previous[j - 1]) / (factor - 1.0);
+    }
+    return 0;
+}
+
+// Best estimate so far
+static inline double romberg_value(const RombergState *s)
+{
+    return s->current[s->level];
+}
+
+// Difference of the last two diagonal entries, used as the error estimate
+static inline double romberg_error(const RombergState *s)
+{
+    return s->level > 0 ? fabs(s->current[s->level] - s->previous[s->level - 1]) : INFINITY;
+}
+
+// Refine until the diagonal agrees to max(abs_tol, rel_tol * |value|) or max_levels is reached.
+// Returns 0 when converged, 1 otherwise (the state can be refined further).
+static inline int romberg_integrate(RombergState *s, double abs_tol, double rel_tol, int max_levels)
+{
+    if (max_levels > ROMBERG_MAX_LEVELS - 1)
+        max_levels = ROMBERG_MAX_LEVELS - 1;
+
+    for (;;)
+    {
+        if (s->level >= ROMBERG_MIN_LEVELS && romberg_error(s) <= fmax(abs_tol, rel_tol * fabs(romberg_value(s))))
+            return 0;
+        if (s->level >= max_levels || romberg_refine(s) != 0)
+            return 1;
+    }
+}
+
+#endif
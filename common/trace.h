@@ -0,0 +1,124 @@
+// Iteration tracing
+// Solvers report each iteration with TRACE(iteration, values...) instead of calling printf.
+// Records go into a ring buffer that keeps the last TRACE_CAPACITY iterations;
+// the iteration table is printed afterwards with trace_print().
+//
+// Compile with -DTRACE_OFF to remove tracing completely: TRACE() and TRACE_VECTOR() expand
+// to nothing, so their arguments are not even evaluated.
+//
+// Set the environment variable TRACE_FILE to also append every record to a binary file:
+//     header:  char magic[8] = "NMTRACE1", char name[32]
+//     records: TraceRecord (int iteration, int count, double values[TRACE_MAX_VALUES])
+//
+// Header only: include it with #include "../common/trace.h".
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define TRACE_CAPACITY 1024  // Iterations kept in the ring buffer (a power of two)
+#define TRACE_MAX_VALUES 12  // Values stored per iteration
+
+// One traced iteration
+typedef struct
+{
+    int iteration;
+    int count; // Number of values used
+    double values[TRACE_MAX_VALUES];
+} TraceRecord;
+
+// Ring buffer of the most recent iterations
+typedef struct
+{
+    TraceRecord records[TRACE_CAPACITY];
+    atomic_ulong head; // Total number of records pushed
+    FILE *dump;        // Binary dump file, NULL when disabled
+} TraceRing;
+
+// Callback that prints one row of the iteration table
+typedef void (*trace_row_printer)(const TraceRecord *record);
+
+#ifdef TRACE_OFF
+
+#define TRACE(iteration, ...) ((void)0)
+#define TRACE_VECTOR(iteration, values, count) ((void)0)
+#define trace_begin(name) ((void)0)
+#define trace_end() ((void)0)
+#define trace_print(print_row) ((void)0)
+
+#else
+
+static TraceRing trace_ring;
+
+// Append one record. The slot is claimed with an atomic counter, but the record itself is
+// written with plain stores, so trace from one thread (or from threads that never wrap onto
+// each other's slots) and only read the ring once the solver has finished
+static inline void trace_push(int iteration, const double values[], int count)
+{
+    unsigned long slot = atomic_fetch_add_explicit(&trace_ring.head, 1, memory_order_relaxed);
+    TraceRecord *record = &trace_ring.records[slot & (TRACE_CAPACITY - 1)];
+
+    if (count > TRACE_MAX_VALUES)
+        count = TRACE_MAX_VALUES;
+    record->iteration = iteration;
+    record->count = count;
+    memcpy(record->values, values, count * sizeof(double));
+
+    if (trace_ring.dump)
+        fwrite(record, sizeof(*record), 1, trace_ring.dump);
+}
+
+#define TRACE(iteration, ...)                                                      \
+    trace_push((iteration), (const double[]){__VA_ARGS__},                         \
+               (int)(sizeof((const double[]){__VA_ARGS__}) / sizeof(double)))
+#define TRACE_VECTOR(iteration, values, count) trace_push((iteration), (values), (count))
+
+// Start a new trace: clears the ring and, if TRACE_FILE is set, starts a dump section
+static inline void trace_begin(const char *name)
+{
+    const char *path = getenv("TRACE_FILE");
+
+    atomic_store(&trace_ring.head, 0);
+    if (path && !trace_ring.dump)
+    {
+        trace_ring.dump = fopen(path, "ab");
+        if (!trace_ring.dump)
+            printf("Error: cannot open trace file %s.\n", path);
+    }
+    if (trace_ring.dump)
+    {
+        char header[40] = "NMTRACE1";
+        strncpy(header + 8, name, 31);
+        fwrite(header, sizeof(header), 1, trace_ring.dump);
+    }
+}
+
+// Close the binary dump; the next trace_begin() appends to the file again
+static inline void trace_end(void)
+{
+    if (trace_ring.dump)
+    {
+        if (fclose(trace_ring.dump) != 0)
+            printf("Error: cannot write the trace file.\n");
+        trace_ring.dump = NULL;
+    }
+}
+
+// Print the kept iterations, oldest first
+static inline void trace_print(trace_row_printer print_row)
+{
+    unsigned long total = atomic_load(&trace_ring.head);
+    unsigned long first = total > TRACE_CAPACITY ? total - TRACE_CAPACITY : 0;
+
+    if (first > 0)
+        printf("... (%lu earlier iterations not kept)\n", first);
+    for (unsigned long i = first; i < total; i++)
+        print_row(&trace_ring.records[i & (TRACE_CAPACITY - 1)]);
+}
+
+#endif // TRACE_OFF
+
+#endif // TRACE_H